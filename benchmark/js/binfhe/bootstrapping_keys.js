@@ -0,0 +1,63 @@
+// Bootstrapping key generation against loading a serialized key, and gate
+// throughput with one EvalBinGate call per gate against one EvalBinGates
+// call per layer.
+//
+//   nodejs benchmark/js/binfhe/bootstrapping_keys.js [PARAMSET]
+//
+// PARAMSET defaults to STD128, e.g. TOY or MEDIUM for a quick run.
+
+const now = () => process.hrtime.bigint()
+const ms = ns => (Number(ns) / 1e6).toFixed(1);
+
+const numGates = 32;
+
+async function main() {
+    const factory = require('../../../lib/openfhe_binfhe')
+    const module = await factory();
+    const paramSet = process.argv[2] || 'STD128';
+
+    const cc = new module.BinFHEContext();
+    cc.GenerateBinFHEContext(module.BINFHE_PARAMSET[paramSet], module.BINFHE_METHOD.GINX);
+    const sk = cc.KeyGen();
+
+    let t = now();
+    cc.BTKeyGen(sk);
+    const keyGenTime = now() - t;
+
+    t = now();
+    const keyBuf = module.SerializeBTKeyToBuffer(cc, module.SerType.BINARY);
+    const serializeTime = now() - t;
+    const ctBuf = module.SerializeBinFHEContextToBuffer(cc, module.SerType.BINARY);
+
+    t = now();
+    const loaded = module.DeserializeBinFHEContextFromBuffer(ctBuf, module.SerType.BINARY);
+    module.BTKeyLoadFromBuffer(loaded, keyBuf, module.SerType.BINARY);
+    const loadTime = now() - t;
+
+    const bits = Uint8Array.from({length: numGates}, (_, i) => i & 1);
+    const cts1 = loaded.EncryptBits(sk, bits);
+    const cts2 = loaded.EncryptBits(sk, bits.map(b => 1 - b));
+
+    t = now();
+    const single = cts1.map((ct, i) => loaded.EvalBinGate(module.BINGATE.NAND, ct, cts2[i]));
+    const singleTime = now() - t;
+
+    t = now();
+    const batched = loaded.EvalBinGates(module.BINGATE.NAND, cts1, cts2);
+    const batchedTime = now() - t;
+
+    const expected = loaded.DecryptBits(sk, single).join();
+    if (loaded.DecryptBits(sk, batched).join() !== expected) throw new Error('batched gates disagree');
+    [...cts1, ...cts2, ...single, ...batched].forEach(ct => ct.delete());
+
+    console.log(`parameter set: \t${paramSet}`);
+    console.log(`BTKeyGen: \t${ms(keyGenTime)} ms`);
+    console.log(`serialize: \t${ms(serializeTime)} ms, ${(keyBuf.byteLength / (1 << 20)).toFixed(1)} MB`);
+    console.log(`load: \t\t${ms(loadTime)} ms (context + BTKeyLoadFromBuffer)`);
+    console.log(`EvalBinGate: \t${(Number(singleTime) / 1e6 / numGates).toFixed(1)} ms/gate`);
+    console.log(`EvalBinGates: \t${(Number(batchedTime) / 1e6 / numGates).toFixed(1)} ms/gate`);
+
+    return 0;
+}
+
+main().then(exitCode => console.log(exitCode));
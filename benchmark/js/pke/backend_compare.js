@@ -0,0 +1,119 @@
+// Compares native word backends on typical CKKS and BFV parameter sets.
+//
+// Pass the module of each build to compare, e.g. a 64-bit and a 32-bit
+// (NATIVE_SIZE=32) build of OpenFHE:
+//
+//   nodejs benchmark/js/pke/backend_compare.js build64/lib/openfhe_pke.js build32/lib/openfhe_pke.js
+//
+// Without arguments the module in lib/ is measured. The RNS moduli are sized
+// to the backend (GetMaxModulusSize), so the 32-bit backend uses about twice
+// as many towers for the same ring dimension; CKKS also reports the precision
+// the smaller scaling factor leaves.
+
+const path = require('path');
+
+const now = () => process.hrtime.bigint();
+const ms = ns => (Number(ns) / 1e6).toFixed(2);
+
+const ringDim = 1 << 14;
+const reps = 10;
+
+// Records the average time of fn over reps runs and returns the result of
+// the last run; the results of the other runs are deleted.
+function time(timings, name, fn) {
+    let result = fn();
+    let elapsed = 0n;
+    for (let i = 0; i < reps; i++) {
+        if (result && result.delete) result.delete();
+        const t = now();
+        result = fn();
+        elapsed += now() - t;
+    }
+    timings[name] = elapsed / BigInt(reps);
+    return result;
+}
+
+function report(cc, timings) {
+    const modulus = cc.GetCryptoParameters().GetElementParams().GetModulus();
+    console.log(`\tlog2 Q: \t${Math.round(Math.log2(modulus.ConvertToDouble()))}`);
+    for (const [name, ns] of Object.entries(timings)) console.log(`\t${name}: \t${ms(ns)} ms`);
+}
+
+function benchmarkCKKS(module) {
+    const maxModSize = module.GetMaxModulusSize();
+    let params = new module.CCParamsCryptoContextCKKSRNS();
+    params.SetSecurityLevel(module.SecurityLevel.HEStd_NotSet);
+    params.SetRingDim(ringDim);
+    params.SetMultiplicativeDepth(6);
+    params.SetFirstModSize(Math.min(60, maxModSize));
+    params.SetScalingModSize(Math.min(50, maxModSize - 3));
+    params.SetBatchSize(ringDim / 2);
+    const cc = new module.GenCryptoContextCKKS(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    cc.Enable(module.PKESchemeFeature.KEYSWITCH);
+    cc.Enable(module.PKESchemeFeature.LEVELEDSHE);
+
+    const kp = cc.KeyGen();
+    const timings = {};
+    time(timings, 'EvalMultKeyGen', () => cc.EvalMultKeyGen(kp.secretKey));
+    cc.EvalAtIndexKeyGen(kp.secretKey, [1]);
+
+    const values = new module.VectorDouble(Array.from({length: 16}, (_, i) => i / 16));
+    const plaintext = cc.MakeCKKSPackedPlaintext(values);
+    const ciphertext = time(timings, 'Encrypt', () => cc.Encrypt(kp.publicKey, plaintext));
+    const product = time(timings, 'EvalMult', () => cc.EvalMultCipherCipher(ciphertext, ciphertext));
+    time(timings, 'EvalAtIndex', () => cc.EvalAtIndex(ciphertext, 1)).delete();
+    const decrypted = time(timings, 'Decrypt', () => cc.Decrypt(kp.secretKey, product));
+
+    console.log(`CKKS (n = ${ringDim}, depth 6)`);
+    report(cc, timings);
+    console.log(`\tprecision: \t${decrypted.GetLogPrecision().toFixed(1)} bits`);
+}
+
+function benchmarkBFV(module) {
+    const maxModSize = module.GetMaxModulusSize();
+    let params = new module.CCParamsCryptoContextBFVRNS();
+    params.SetSecurityLevel(module.SecurityLevel.HEStd_NotSet);
+    params.SetRingDim(ringDim);
+    params.SetPlaintextModulus(65537);
+    params.SetMultiplicativeDepth(3);
+    params.SetScalingModSize(Math.min(60, maxModSize));
+    const cc = new module.GenCryptoContextBFV(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    cc.Enable(module.PKESchemeFeature.KEYSWITCH);
+    cc.Enable(module.PKESchemeFeature.LEVELEDSHE);
+
+    const kp = cc.KeyGen();
+    const timings = {};
+    time(timings, 'EvalMultKeyGen', () => cc.EvalMultKeyGen(kp.secretKey));
+    cc.EvalAtIndexKeyGen(kp.secretKey, [1]);
+
+    const plaintext = cc.MakePackedPlaintext(
+        module.MakeVectorInt64Clipped(Array.from({length: 16}, (_, i) => i)));
+    const ciphertext = time(timings, 'Encrypt', () => cc.Encrypt(kp.publicKey, plaintext));
+    const product = time(timings, 'EvalMult', () => cc.EvalMultCipherCipher(ciphertext, ciphertext));
+    time(timings, 'EvalAtIndex', () => cc.EvalAtIndex(ciphertext, 1)).delete();
+    time(timings, 'Decrypt', () => cc.Decrypt(kp.secretKey, product)).delete();
+
+    console.log(`BFV (n = ${ringDim}, t = 65537, depth 3)`);
+    report(cc, timings);
+}
+
+async function main() {
+    const modules = process.argv.length > 2
+        ? process.argv.slice(2).map(file => path.resolve(file))
+        : ['../../../lib/openfhe_pke'];
+
+    for (const file of modules) {
+        const factory = require(file);
+        const module = await factory();
+        console.log(`${file}: ${module.GetBackendSize()}-bit backend, ` +
+            `moduli up to ${module.GetMaxModulusSize()} bits`);
+        benchmarkCKKS(module);
+        benchmarkBFV(module);
+    }
+
+    return 0;
+}
+
+main().then(exitCode => console.log(exitCode));
@@ -0,0 +1,62 @@
+// Latency of a query touching 1% of an encrypted table stored as a
+// ciphertext collection file: deserializing the whole table up front against
+// reading only the touched ciphertexts with CiphertextCollectionReader, for
+// both collection encodings.
+
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+const now = () => process.hrtime.bigint() / 1000000n
+
+const tableSize = 400;
+const touched = 4;
+
+async function main() {
+    const factory = require('../../../lib/openfhe_pke')
+    const module = await factory();
+
+    const params = new module.CCParamsCryptoContextCKKSRNS();
+    params.SetMultiplicativeDepth(2);
+    params.SetScalingModSize(50);
+    const cc = new module.GenCryptoContextCKKS(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    const kp = cc.KeyGen();
+
+    const ciphertext = cc.Encrypt(kp.publicKey, cc.MakeCKKSPackedPlaintext(new module.VectorDouble([1, 2, 3])));
+    const rows = Array.from({length: touched}, (_, i) => Math.floor((i + 0.5) * tableSize / touched));
+
+    console.log(`n = ${cc.GetRingDimension()}, ${tableSize} ciphertexts, ${touched} touched`);
+    console.log('encoding \tfile MB \tload all ms \tlazy ms');
+    for (const encoding of ['binary', 'raw']) {
+        const file = path.join(os.tmpdir(), `openfhe_collection_${encoding}_${process.pid}.bin`);
+        try {
+            const writer = new module.CiphertextCollectionWriter(cc, file, {encoding});
+            for (let i = 0; i < tableSize; i++) writer.append(ciphertext);
+            writer.close();
+
+            let t = now();
+            const all = new module.CiphertextCollectionReader(cc, file, {cacheSize: 0});
+            const table = [];
+            for (let i = 0; i < tableSize; i++) table.push(all.get(i));
+            const loadAllMs = Number(now() - t);
+            table.forEach(ct => ct.delete());
+            all.close();
+
+            t = now();
+            const reader = new module.CiphertextCollectionReader(cc, file);
+            rows.forEach(i => reader.get(i).delete());
+            const lazyMs = Number(now() - t);
+            reader.close();
+
+            const mb = (fs.statSync(file).size / (1 << 20)).toFixed(1);
+            console.log(`${encoding} \t\t${mb} \t\t${loadAllMs} \t\t${lazyMs}`);
+        } finally {
+            fs.rmSync(file, {force: true});
+        }
+    }
+
+    return 0;
+}
+
+main().then(exitCode => console.log(exitCode));
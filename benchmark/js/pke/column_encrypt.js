@@ -0,0 +1,56 @@
+// Rows/sec of streaming a numeric column through EncryptColumnToStream into
+// a file: CKKS for a Float64 column and BFV for an Int32 column. The column
+// is generated chunk by chunk, as it would be read from a larger-than-memory
+// dataset, and the file I/O overlaps the encryption of the next chunk.
+
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+const rows = 1 << 17;
+const chunkRows = 1 << 13;
+
+async function* column(ArrayType) {
+    for (let offset = 0; offset < rows; offset += chunkRows) {
+        const chunk = new ArrayType(chunkRows);
+        for (let i = 0; i < chunkRows; i++) chunk[i] = (offset + i) % 1000;
+        yield chunk;
+    }
+}
+
+async function run(module, name, cc, ArrayType) {
+    const kp = cc.KeyGen();
+    const file = path.join(os.tmpdir(), `openfhe_column_${name}_${process.pid}.bin`);
+    try {
+        const stats = await module.EncryptColumnToStream(cc, kp.publicKey, column(ArrayType), file);
+        console.log(`${name} \t${stats.rows} \t${(stats.bytes / (1 << 20)).toFixed(1)} \t` +
+            `${stats.seconds.toFixed(2)} \t${stats.rowsPerSecond.toFixed(0)}`);
+    } finally {
+        fs.rmSync(file, {force: true});
+    }
+}
+
+async function main() {
+    const factory = require('../../../lib/openfhe_pke')
+    const module = await factory();
+
+    console.log('scheme \trows \tMB \ts \trows/s');
+
+    const ckksParams = new module.CCParamsCryptoContextCKKSRNS();
+    ckksParams.SetMultiplicativeDepth(1);
+    ckksParams.SetScalingModSize(50);
+    const ckks = new module.GenCryptoContextCKKS(ckksParams);
+    ckks.Enable(module.PKESchemeFeature.PKE);
+    await run(module, 'CKKS', ckks, Float64Array);
+
+    const bfvParams = new module.CCParamsCryptoContextBFVRNS();
+    bfvParams.SetPlaintextModulus(65537);
+    bfvParams.SetMultiplicativeDepth(1);
+    const bfv = new module.GenCryptoContextBFV(bfvParams);
+    bfv.Enable(module.PKESchemeFeature.PKE);
+    await run(module, 'BFV', bfv, Int32Array);
+
+    return 0;
+}
+
+main().then(exitCode => console.log(exitCode));
@@ -0,0 +1,84 @@
+// Compares an accumulation loop written with the allocating wrappers
+// (EvalAddCipherCipher, EvalMultCipherConstant, ModReduce) against the
+// in-place variants. Reports wall time, the number of JS handles that have
+// to be deleted, and the growth of the live WASM heap.
+
+const now = () => process.hrtime.bigint() / 1000000n
+
+const numTerms = 64;
+
+async function main() {
+    const factory = require('../../../lib/openfhe_pke')
+    const module = await factory();
+
+    let params = new module.CCParamsCryptoContextCKKSRNS();
+    params.SetMultiplicativeDepth(2);
+    params.SetScalingModSize(50);
+    params.SetBatchSize(16);
+    params.SetScalingTechnique(module.ScalingTechnique.FIXEDMANUAL);
+    let cc = new module.GenCryptoContextCKKS(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    cc.Enable(module.PKESchemeFeature.LEVELEDSHE);
+
+    const kp = cc.KeyGen();
+    const input = new module.VectorDouble([1, 2, 3, 4, 5, 6, 7, 8]);
+    const plaintext = cc.MakeCKKSPackedPlaintext(input);
+    // the in-place loop consumes its terms, so each variant gets its own
+    // encryptions, made before the clock starts
+    const encryptTerms = () => Array.from({length: numTerms}, () => cc.Encrypt(kp.publicKey, plaintext));
+
+    ////////////////////////////////////////////////////////////
+    // Allocating wrappers
+    ////////////////////////////////////////////////////////////
+
+    let terms = encryptTerms();
+    let heapBefore = module.GetHeapInUse();
+    let t = now();
+    let handles = [];
+    let acc = cc.EvalMultCipherConstant(terms[0], 0.5);
+    handles.push(acc);
+    for (let i = 1; i < numTerms; i++) {
+        const scaled = cc.EvalMultCipherConstant(terms[i], 0.5);
+        acc = cc.EvalAddCipherCipher(acc, scaled);
+        handles.push(scaled, acc);
+    }
+    acc = cc.ModReduce(acc);
+    handles.push(acc);
+    const allocTime = now() - t;
+    const allocHeap = module.GetHeapInUse() - heapBefore;
+    const allocHandles = handles.length;
+    handles.forEach(h => h.delete());
+    terms.forEach(term => term.delete());
+
+    ////////////////////////////////////////////////////////////
+    // In-place variants: the same multiplications and additions, with
+    // every term scaled in place and added into the first one
+    ////////////////////////////////////////////////////////////
+
+    terms = encryptTerms();
+    heapBefore = module.GetHeapInUse();
+    t = now();
+    const accInPlace = terms[0];
+    cc.EvalMultInPlace(accInPlace, 0.5);
+    for (let i = 1; i < numTerms; i++) {
+        cc.EvalMultInPlace(terms[i], 0.5);
+        cc.EvalAddInPlace(accInPlace, terms[i]);
+    }
+    cc.ModReduceInPlace(accInPlace);
+    const inPlaceTime = now() - t;
+    const inPlaceHeap = module.GetHeapInUse() - heapBefore;
+    const inPlaceHandles = 0;  // the loop creates no handles
+
+    const decrypted = cc.Decrypt(kp.secretKey, accInPlace);
+    decrypted.SetLength(8);
+    terms.forEach(term => term.delete());
+
+    console.log(`terms accumulated: \t${numTerms}`);
+    console.log(`allocating: \t${allocTime} ms, \t${allocHandles} handles, \t${allocHeap} bytes live`);
+    console.log(`in-place: \t${inPlaceTime} ms, \t${inPlaceHandles} handles, \t${inPlaceHeap} bytes live`);
+    console.log(`result: ${decrypted}`);
+
+    return 0;
+}
+
+main().then(exitCode => console.log(exitCode));
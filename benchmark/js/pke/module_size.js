@@ -0,0 +1,37 @@
+// Compares the full module with the slim client modules (see
+// src/pke/client_em.cpp): .wasm size, gzip-compressed size, and the time
+// until factory() resolves, i.e. compilation plus instantiation. Modules
+// that were not built are skipped.
+
+const fs = require('fs');
+const path = require('path');
+const zlib = require('zlib');
+
+const libDir = path.join(__dirname, '../../../lib');
+const modules = ['openfhe_pke', 'openfhe_pke_client_ckks', 'openfhe_pke_client_bfv', 'openfhe_pke_encrypt_ckks'];
+
+const kb = bytes => (bytes / 1024).toFixed(0);
+
+async function main() {
+    console.log('module \t\twasm KB \tgzip KB \tinstantiate ms');
+    for (const name of modules) {
+        const wasmPath = path.join(libDir, name + '.wasm');
+        if (!fs.existsSync(wasmPath)) {
+            console.log(`${name} \tnot built`);
+            continue;
+        }
+        const wasm = fs.readFileSync(wasmPath);
+        const gzipped = zlib.gzipSync(wasm, {level: 9});
+
+        const factory = require(path.join(libDir, name));
+        const t = performance.now();
+        await factory();
+        const instantiateTime = performance.now() - t;
+
+        console.log(`${name} \t${kb(wasm.length)} \t${kb(gzipped.length)} \t${instantiateTime.toFixed(1)}`);
+    }
+
+    return 0;
+}
+
+main().then(exitCode => console.log(exitCode));
@@ -0,0 +1,70 @@
+// Measures the time to the first Encrypt (EncryptPKPT) of a small CKKS
+// context, which includes loading the module, generating the context and a
+// key pair:
+//  - in a new process with the plain factory(),
+//  - in a new process with the loader and an empty, then a filled, disk cache,
+//  - in-process, instantiating the already compiled module again,
+//  - in-process, checking an instance out of a pre-filled pool.
+// The new-process timings are taken from process start.
+
+const {execFileSync} = require('child_process');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+const libDir = path.join(__dirname, '../../../lib');
+
+function firstEncrypt(module) {
+    let params = new module.CCParamsCryptoContextCKKSRNS();
+    params.SetSecurityLevel(module.SecurityLevel.HEStd_NotSet);
+    params.SetRingDim(1 << 12);
+    params.SetMultiplicativeDepth(1);
+    params.SetScalingModSize(50);
+    const cc = new module.GenCryptoContextCKKS(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    const kp = cc.KeyGen();
+    cc.Encrypt(kp.publicKey, cc.MakeCKKSPackedPlaintext(new module.VectorDouble([1, 2, 3])));
+}
+
+async function child(mode, cacheDir) {
+    const loader = require(path.join(libDir, 'openfhe_loader'));
+    if (mode === 'loader') loader.enableDiskCache(cacheDir);
+    const module = mode === 'loader' ? await loader.instantiate() : await require(path.join(libDir, 'openfhe_pke'))();
+    firstEncrypt(module);
+    console.log(performance.now().toFixed(1));
+}
+
+function spawn(mode, cacheDir) {
+    return execFileSync(process.execPath, [__filename, '--child', mode, cacheDir || '']).toString().trim();
+}
+
+async function main() {
+    const loader = require(path.join(libDir, 'openfhe_loader'));
+    const cacheDir = fs.mkdtempSync(path.join(os.tmpdir(), 'openfhe-cache-'));
+
+    console.log('new process');
+    console.log(`\tfactory(): \t${spawn('factory')} ms`);
+    console.log(`\tloader, cold cache: \t${spawn('loader', cacheDir)} ms`);
+    console.log(`\tloader, warm cache: \t${spawn('loader', cacheDir)} ms`);
+    fs.rmSync(cacheDir, {recursive: true, force: true});
+
+    await loader.compileModule();
+    let t = performance.now();
+    firstEncrypt(await loader.instantiate());
+    console.log('same process');
+    console.log(`\tinstantiate(): \t${(performance.now() - t).toFixed(1)} ms`);
+
+    const pool = new loader.InstancePool(2);
+    await pool.ready;
+    t = performance.now();
+    await pool.run(firstEncrypt);
+    console.log(`\tpool checkout: \t${(performance.now() - t).toFixed(1)} ms`);
+
+    return 0;
+}
+
+if (process.argv[2] === '--child') {
+    child(process.argv[3], process.argv[4]);
+} else {
+    main().then(exitCode => console.log(exitCode));
+}
@@ -0,0 +1,30 @@
+// Runs TuneParameters on a CKKS workload (depth 4, two rotations, a mix of
+// multiplications, additions and rotations) and prints every candidate's
+// time per workload run next to OpenFHE's default parameters.
+
+const describe = settings => Object.entries(settings).map(([key, value]) => `${key}=${value}`).join(' ') || 'default';
+
+async function main() {
+    const factory = require('../../../lib/openfhe_pke')
+    const module = await factory();
+
+    const workload = {
+        multiplicativeDepth: 4,
+        rotations: [1, 8],
+        ops: {mult: 4, add: 8, rotate: 4},
+        precisionBits: 20,
+    };
+    const baseline = await module.TuneParameters(workload, {candidates: [{}]});
+    const tuned = await module.TuneParameters(workload, {
+        onProgress: (done, total, result) => console.log(`${done}/${total} \t` + (result.ok ?
+            `${result.msPerWorkload.toFixed(1)} ms \tn = ${result.ringDimension} \t` +
+            `${result.precisionBits.toFixed(1)} bits` : 'rejected') + ` \t${describe(result.settings)}`),
+    });
+
+    console.log(`default: \t${baseline.msPerWorkload.toFixed(1)} ms per workload run`);
+    console.log(`tuned: \t\t${tuned.msPerWorkload.toFixed(1)} ms per workload run \t${describe(tuned.settings)}`);
+
+    return 0;
+}
+
+main().then(exitCode => console.log(exitCode));
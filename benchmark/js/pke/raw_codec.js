@@ -0,0 +1,47 @@
+// Compares SerializeCiphertextToBuffer (cereal, binary) with the same-context
+// raw codec, SerializeCiphertextToRawBuffer, on fresh CKKS ciphertexts of
+// growing size: encode and decode time, and buffer size.
+
+const now = () => process.hrtime.bigint()
+const ms = ns => (Number(ns) / 1e6).toFixed(2);
+
+const ringDims = [1 << 13, 1 << 14, 1 << 15];
+const reps = 10;
+
+function time(fn) {
+    let result;
+    const t = now();
+    for (let i = 0; i < reps; i++) result = fn();
+    return [(now() - t) / BigInt(reps), result];
+}
+
+async function main() {
+    const factory = require('../../../lib/openfhe_pke')
+    const module = await factory();
+
+    for (const ringDim of ringDims) {
+        let params = new module.CCParamsCryptoContextCKKSRNS();
+        params.SetSecurityLevel(module.SecurityLevel.HEStd_NotSet);
+        params.SetRingDim(ringDim);
+        params.SetMultiplicativeDepth(10);
+        params.SetScalingModSize(50);
+        const cc = new module.GenCryptoContextCKKS(params);
+        cc.Enable(module.PKESchemeFeature.PKE);
+        const kp = cc.KeyGen();
+        const ciphertext = cc.Encrypt(kp.publicKey, cc.MakeCKKSPackedPlaintext(new module.VectorDouble([1, 2, 3])));
+
+        const [cerealOut, cerealBuf] = time(() => module.SerializeCiphertextToBuffer(ciphertext, module.SerType.BINARY));
+        const [cerealIn] = time(() => module.DeserializeCiphertextFromBuffer(cerealBuf, module.SerType.BINARY));
+        const [rawOut, rawBuf] = time(() => module.SerializeCiphertextToRawBuffer(cc, ciphertext));
+        const [rawIn] = time(() => module.DeserializeCiphertextFromRawBuffer(cc, rawBuf));
+
+        console.log(`n = ${ringDim}`);
+        console.log(`\tcereal: \tencode ${ms(cerealOut)} ms \tdecode ${ms(cerealIn)} ms \t${cerealBuf.byteLength} bytes`);
+        console.log(`\traw: \t\tencode ${ms(rawOut)} ms \tdecode ${ms(rawIn)} ms \t${rawBuf.byteLength} bytes`);
+        module.ReleaseAllContexts();
+    }
+
+    return 0;
+}
+
+main().then(exitCode => console.log(exitCode));
@@ -0,0 +1,92 @@
+// Memory and load time of evaluation keys in a pool of worker_threads. Each
+// worker loads the relinearization key and the rotation keys of its shard,
+// either from its own copy of the serialized keys or from a
+// SharedSerializedKeyCache, whose serialized keys live once in a
+// SharedArrayBuffer. Both pools deserialize the same keys, so the difference
+// is the serialized copies; the deserialized keys are paid in every worker
+// either way.
+
+const {Worker, isMainThread, parentPort, workerData} = require('worker_threads');
+
+const numWorkers = 4;
+const rotations = Array.from({length: 16}, (_, i) => i + 1);
+
+const mb = bytes => (bytes / (1 << 20)).toFixed(0);
+
+async function worker() {
+    const factory = require('../../../lib/openfhe_pke')
+    const module = await factory();
+    const serType = module.SerType.BINARY;
+    const cc = module.DeserializeCryptoContextFromBuffer(workerData.context, serType);
+
+    const t = performance.now();
+    if (workerData.mode === 'private') {
+        cc.DeserializeEvalMultKeyFromBuffer(workerData.evalMultKey, serType);
+        cc.DeserializeEvalAutomorphismKeyForTagFromBuffer(
+            workerData.evalAutomorphismKey, workerData.keyTag, workerData.shard, serType);
+    } else {
+        new module.SharedSerializedKeyCache(workerData.descriptor).ensure(cc, workerData.shard);
+    }
+    parentPort.postMessage(performance.now() - t);
+    // stay alive until the main thread has measured
+    parentPort.once('message', () => process.exit(0));
+}
+
+async function runPool(data) {
+    const rssBefore = process.memoryUsage().rss;
+    const workers = Array.from({length: numWorkers}, (_, i) => new Worker(__filename, {
+        workerData: Object.assign({shard: rotations.filter((_, r) => r % numWorkers === i)}, data),
+    }));
+    const loadMs = await Promise.all(workers.map(w => new Promise(resolve => w.once('message', resolve))));
+    const rss = process.memoryUsage().rss - rssBefore;
+    await Promise.all(workers.map(w => {
+        const exited = new Promise(resolve => w.once('exit', resolve));
+        w.postMessage('exit');
+        return exited;
+    }));
+    return {rss, loadMs: Math.max(...loadMs)};
+}
+
+async function main() {
+    const factory = require('../../../lib/openfhe_pke')
+    if (factory.native) {
+        // one addon per process: the workers would share, and race on, OpenFHE's key maps
+        console.log('serialized_key_cache.js measures the web-assembly build');
+        return 0;
+    }
+    const module = await factory();
+    const serType = module.SerType.BINARY;
+
+    const params = new module.CCParamsCryptoContextCKKSRNS();
+    params.SetMultiplicativeDepth(4);
+    params.SetScalingModSize(50);
+    const cc = new module.GenCryptoContextCKKS(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    cc.Enable(module.PKESchemeFeature.KEYSWITCH);
+    cc.Enable(module.PKESchemeFeature.LEVELEDSHE);
+    const kp = cc.KeyGen();
+    cc.EvalMultKeyGen(kp.secretKey);
+    cc.EvalAtIndexKeyGen(kp.secretKey, rotations);
+
+    const context = module.SerializeCryptoContextToBuffer(cc, serType);
+    const evalMultKey = cc.SerializeEvalMultKeyToBuffer(serType);
+    const evalAutomorphismKey = cc.SerializeEvalAutomorphismKeyToBuffer(serType);
+    const cache = module.SharedSerializedKeyCache.create(cc, kp.secretKey.GetKeyTag(), {rotations});
+
+    console.log(`n = ${cc.GetRingDimension()}, ${rotations.length} rotation keys, ${numWorkers} workers, ` +
+        `${mb(cache.byteLength)} MB of serialized keys`);
+    console.log('keys \t\tRSS MB \tload ms');
+    const keyTag = kp.secretKey.GetKeyTag();
+    const private_ = await runPool({mode: 'private', context, evalMultKey, evalAutomorphismKey, keyTag});
+    console.log(`per worker \t${mb(private_.rss)} \t${private_.loadMs.toFixed(0)}`);
+    const shared = await runPool({mode: 'shared', context, descriptor: cache.descriptor});
+    console.log(`shared cache \t${mb(shared.rss)} \t${shared.loadMs.toFixed(0)}`);
+
+    return 0;
+}
+
+if (isMainThread) {
+    main().then(exitCode => console.log(exitCode));
+} else {
+    worker();
+}
@@ -0,0 +1,66 @@
+// Measures the time to obtain a ready CKKS context in a cold module:
+// generating it from parameters, deserializing it with
+// DeserializeCryptoContextFromBuffer, which reads the Q moduli but builds all
+// CRT and NTT tables, and restoring it from a snapshot, which also loads the
+// NTT tables of the Q and P moduli. The snapshot is restored once with the
+// EAGER policy and once with LAZY, which leaves the remaining CRT tables to
+// the first use of the context (timed here with EnsureCRTTables()).
+//
+// OpenFHE caches NTT tables per modulus for the life of the module, so every
+// step runs in a new module instance. The native addon is a single instance
+// per process, so with it only the generate step is cold.
+
+const now = () => process.hrtime.bigint() / 1000000n
+
+const ringDims = [1 << 13, 1 << 14, 1 << 15];
+
+async function main() {
+    const factory = require('../../../lib/openfhe_pke')
+
+    for (const ringDim of ringDims) {
+        let module = await factory();
+        let params = new module.CCParamsCryptoContextCKKSRNS();
+        params.SetSecurityLevel(module.SecurityLevel.HEStd_NotSet);
+        params.SetRingDim(ringDim);
+        params.SetMultiplicativeDepth(10);
+        params.SetScalingModSize(50);
+
+        let t = now();
+        const cc = new module.GenCryptoContextCKKS(params);
+        const generateTime = now() - t;
+
+        const buffer = module.SerializeCryptoContextToBuffer(cc, module.SerType.BINARY);
+        const snapshot = module.ExportContextSnapshot(cc);
+
+        module = await factory();
+        module.ReleaseAllContexts();
+        t = now();
+        module.DeserializeCryptoContextFromBuffer(buffer, module.SerType.BINARY);
+        const deserializeTime = now() - t;
+
+        module = await factory();
+        module.ReleaseAllContexts();
+        t = now();
+        module.RestoreContextSnapshot(snapshot, module.CRTPrecomputePolicy.EAGER);
+        const restoreTime = now() - t;
+
+        module = await factory();
+        module.ReleaseAllContexts();
+        t = now();
+        const lazy = module.RestoreContextSnapshot(snapshot, module.CRTPrecomputePolicy.LAZY);
+        const lazyTime = now() - t;
+        t = now();
+        module.EnsureCRTTables(lazy);
+        const tablesTime = now() - t;
+
+        console.log(`n = ${ringDim}`);
+        console.log(`\tgenerate: \t${generateTime} ms`);
+        console.log(`\tdeserialize: \t${deserializeTime} ms \t(${buffer.byteLength} bytes)`);
+        console.log(`\tsnapshot: \t${restoreTime} ms \t(${snapshot.byteLength} bytes)`);
+        console.log(`\tsnapshot lazy: \t${lazyTime} ms \t(+${tablesTime} ms on first use)`);
+    }
+
+    return 0;
+}
+
+main().then(exitCode => console.log(exitCode));
@@ -0,0 +1,68 @@
+// Compares a 64-term CKKS dot product over ciphertext pairs computed with
+// EvalMultCipherCipher, which relinearizes every product, against the fused
+// EvalSumOfProducts, which relinearizes the accumulated sum once.
+
+const now = () => process.hrtime.bigint()
+const ms = ns => (Number(ns) / 1e6).toFixed(2);
+
+const numTerms = 64;
+const reps = 5;
+
+async function main() {
+    const factory = require('../../../lib/openfhe_pke')
+    const module = await factory();
+
+    let params = new module.CCParamsCryptoContextCKKSRNS();
+    params.SetMultiplicativeDepth(2);
+    params.SetScalingModSize(50);
+    params.SetBatchSize(16);
+    let cc = new module.GenCryptoContextCKKS(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    cc.Enable(module.PKESchemeFeature.KEYSWITCH);
+    cc.Enable(module.PKESchemeFeature.LEVELEDSHE);
+
+    const kp = cc.KeyGen();
+    cc.EvalMultKeyGen(kp.secretKey);
+
+    const encrypt = i => cc.Encrypt(kp.publicKey, cc.MakeCKKSPackedPlaintext(
+        new module.VectorDouble(Array.from({length: 16}, (_, j) => ((i + j) % 8) / 8))));
+    const cts1 = Array.from({length: numTerms}, (_, i) => encrypt(i));
+    const cts2 = Array.from({length: numTerms}, (_, i) => encrypt(i + 3));
+
+    let separate = 0n;
+    let fused = 0n;
+    let resultSeparate, resultFused;
+    for (let r = 0; r < reps; r++) {
+        if (resultSeparate) [resultSeparate, resultFused].forEach(h => h.delete());
+
+        let t = now();
+        resultSeparate = cc.EvalMultCipherCipher(cts1[0], cts2[0]);
+        for (let i = 1; i < numTerms; i++) {
+            const product = cc.EvalMultCipherCipher(cts1[i], cts2[i]);
+            cc.EvalAddInPlace(resultSeparate, product);
+            product.delete();
+        }
+        separate += now() - t;
+
+        t = now();
+        resultFused = cc.EvalSumOfProducts(cts1, cts2);
+        fused += now() - t;
+    }
+
+    const decryptSeparate = cc.Decrypt(kp.secretKey, resultSeparate);
+    const decryptFused = cc.Decrypt(kp.secretKey, resultFused);
+    const a = decryptSeparate.GetRealPackedValue();
+    const b = decryptFused.GetRealPackedValue();
+    let maxDiff = 0;
+    for (let i = 0; i < 16; i++) maxDiff = Math.max(maxDiff, Math.abs(a.get(i) - b.get(i)));
+
+    console.log(`terms: \t\t${numTerms}`);
+    console.log(`EvalMult + EvalAdd: \t${ms(separate / BigInt(reps))} ms (${numTerms} relinearizations)`);
+    console.log(`EvalSumOfProducts: \t${ms(fused / BigInt(reps))} ms (1 relinearization)`);
+    console.log(`speedup: \t${(Number(separate) / Number(fused)).toFixed(2)}x`);
+    console.log(`max difference: \t${maxDiff.toExponential(2)}`);
+
+    return 0;
+}
+
+main().then(exitCode => console.log(exitCode));
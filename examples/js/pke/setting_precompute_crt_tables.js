@@ -33,6 +33,20 @@ async function main() {
     module.EnablePrecomputeCRTTablesAfterDeserializaton();
     console.log()
 
+    // The cached deserializer picks the precompute policy per context and
+    // leaves the global switch untouched. Deserializing the same bytes again
+    // returns the cached context without parsing.
+    const buffer = module.SerializeCryptoContextToBuffer(cc, module.SerType.BINARY);
+    const ccLazy = module.DeserializeCryptoContextFromBufferCached(
+        buffer, module.SerType.BINARY, module.CRTPrecomputePolicy.LAZY);
+    module.DeserializeCryptoContextFromBufferCached(
+        buffer, module.SerType.BINARY, module.CRTPrecomputePolicy.LAZY);
+    console.log(`cache hits: ${module.GetCryptoContextCacheHits()}, misses: ${
+        module.GetCryptoContextCacheMisses()
+    }`);
+    // build the CRT tables before the first evaluation
+    module.EnsureCRTTables(ccLazy);
+
     return 0;
 }
 
@@ -205,6 +205,23 @@ async function main() {
     console.log("\n Fused result after the Summation of ciphertext 3: (should be 56)\n");
     console.log(plaintextMultipartyEvalSum.toString());
 
+    ////////////////////////////////////////////////////////////
+    // Batched distributed decryption
+    ////////////////////////////////////////////////////////////
+
+    // each party decrypts the whole batch in one call and ships one compact
+    // buffer; 0 keeps all towers of the ciphertexts
+    const batch = [ciphertextAdd123, ciphertextMult, ciphertextEvalSum];
+    const partialBatch1 = cc.MultipartyDecryptLeadBatch(kp1.secretKey, batch, 0);
+    const partialBatch2 = cc.MultipartyDecryptMainBatch(kp2.secretKey, batch, 0);
+    console.log(`\n Partial decryption batch sizes: ${partialBatch1.byteLength}, ${partialBatch2.byteLength} bytes`);
+
+    const fusedBatch = cc.MultipartyDecryptFusionBatch([partialBatch1, partialBatch2]);
+    fusedBatch.forEach(plaintext => {
+        plaintext.SetLength(plaintext1.GetLength());
+        console.log(plaintext.toString());
+    });
+
     return 0;
 }
 
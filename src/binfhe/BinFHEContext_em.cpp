@@ -0,0 +1,202 @@
+// OpenFHE Includes
+#include "binfhecontext.h"
+#include "binfhecontext-ser.h"
+using namespace lbcrypto;
+
+// Emscripten includes.
+#include <emscripten.h>
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+using namespace emscripten;
+
+// Local emscripten binding includes.
+#include "core/exception_em.h"
+#include "core/version_em.h"
+#include "core/memory_em.h"
+#include "binfhe_serial_em.h"
+
+// NOTE: as in the pke bindings, the wrappers below take LWECiphertext and
+// LWEPrivateKey because embind does not convert them to the Const* pointer
+// types the BinFHEContext methods are declared with.
+
+/**
+ * @brief Encrypt a bit, or a message modulo p.
+ * @param cc - Reference to BinFHEContext from JS.
+ * @param sk - secret key.
+ * @param message - message to encrypt.
+ * @return ciphertext refreshed with the bootstrapping parameters.
+ */
+LWECiphertext EncryptBit(const std::shared_ptr<BinFHEContext> &cc, LWEPrivateKey sk, int32_t message) {
+  return cc->Encrypt(sk, message);
+}
+
+/**
+ * @brief Decrypt a ciphertext encrypted with Encrypt() or output by a gate.
+ * @param cc - Reference to BinFHEContext from JS.
+ * @param sk - secret key.
+ * @param ct - ciphertext.
+ * @return decrypted bit.
+ */
+int32_t DecryptBit(const std::shared_ptr<BinFHEContext> &cc, LWEPrivateKey sk, LWECiphertext ct) {
+  LWEPlaintext result;
+  cc->Decrypt(sk, ct, &result);
+  return static_cast<int32_t>(result);
+}
+
+/**
+ * @brief Generates the bootstrapping key (refresh and key switching keys)
+ * for a secret key and keeps it in the context.
+ * @param cc - Reference to BinFHEContext from JS.
+ * @param sk - secret key.
+ */
+void BTKeyGen(const std::shared_ptr<BinFHEContext> &cc, LWEPrivateKey sk) { cc->BTKeyGen(sk); }
+
+/**
+ * @brief Evaluates a binary gate with bootstrapping.
+ * @param cc - Reference to BinFHEContext from JS.
+ * @param gate - the gate; can be AND, OR, NAND, NOR, XOR, or XNOR.
+ * @param ct1 - first ciphertext.
+ * @param ct2 - second ciphertext.
+ * @return the output ciphertext.
+ */
+LWECiphertext EvalBinGate(const std::shared_ptr<BinFHEContext> &cc, BINGATE gate, LWECiphertext ct1,
+                          LWECiphertext ct2) {
+  return cc->EvalBinGate(gate, ct1, ct2);
+}
+
+/**
+ * @brief Evaluates NOT, which needs no bootstrapping.
+ */
+LWECiphertext EvalNOT(const std::shared_ptr<BinFHEContext> &cc, LWECiphertext ct) { return cc->EvalNOT(ct); }
+
+/**
+ * @brief Bootstraps a ciphertext, refreshing its noise.
+ */
+LWECiphertext Bootstrap(const std::shared_ptr<BinFHEContext> &cc, LWECiphertext ct) { return cc->Bootstrap(ct); }
+
+// Batched variants. One call crosses the JS/WASM boundary once for a whole
+// layer of a circuit instead of once per gate, and the gate outputs are
+// returned together.
+
+/**
+ * @brief Encrypts each bit of an array.
+ * @param cc - Reference to BinFHEContext from JS.
+ * @param sk - secret key.
+ * @param bits - Uint8Array or array of 0/1 values.
+ * @return JS array of ciphertexts.
+ */
+emscripten::val EncryptBits(const std::shared_ptr<BinFHEContext> &cc, LWEPrivateKey sk, const emscripten::val &bits) {
+  auto result = emscripten::val::array();
+  for (const auto bit : convertJSArrayToNumberVector<int32_t>(bits)) {
+    result.call<void>("push", cc->Encrypt(sk, bit));
+  }
+  return result;
+}
+
+/**
+ * @brief Decrypts an array of ciphertexts.
+ * @param cc - Reference to BinFHEContext from JS.
+ * @param sk - secret key.
+ * @param ciphertexts - JS array of ciphertexts.
+ * @return decrypted bits as a Uint8Array.
+ */
+emscripten::val DecryptBits(const std::shared_ptr<BinFHEContext> &cc, LWEPrivateKey sk,
+                            const emscripten::val &ciphertexts) {
+  const auto cts = vecFromJSArray<LWECiphertext>(ciphertexts);
+  std::vector<uint8_t> bits(cts.size());
+  for (size_t i = 0; i < cts.size(); i++) {
+    LWEPlaintext result;
+    cc->Decrypt(sk, cts[i], &result);
+    bits[i] = static_cast<uint8_t>(result);
+  }
+  return val::global("Uint8Array").new_(emscripten::typed_memory_view(bits.size(), bits.data()));
+}
+
+/**
+ * @brief Evaluates a layer of binary gates, gates[i](cts1[i], cts2[i]).
+ * @param cc - Reference to BinFHEContext from JS.
+ * @param gates - JS array of BINGATE values, or a single gate for all pairs.
+ * @param ciphertexts1 - JS array of first inputs.
+ * @param ciphertexts2 - JS array of second inputs, same length.
+ * @return JS array of the output ciphertexts.
+ */
+emscripten::val EvalBinGates(const std::shared_ptr<BinFHEContext> &cc,
+                             const emscripten::val &gates,
+                             const emscripten::val &ciphertexts1,
+                             const emscripten::val &ciphertexts2) {
+  const auto lhs = vecFromJSArray<LWECiphertext>(ciphertexts1);
+  const auto rhs = vecFromJSArray<LWECiphertext>(ciphertexts2);
+  const auto gateVec = gates.isArray() ? vecFromJSArray<BINGATE>(gates) : std::vector<BINGATE>{gates.as<BINGATE>()};
+  if (lhs.size() != rhs.size() || (gateVec.size() != 1 && gateVec.size() != lhs.size())) {
+    OPENFHE_THROW("EvalBinGates needs one gate or one gate per input pair, and input lists of equal length");
+  }
+
+  auto result = emscripten::val::array();
+  for (size_t i = 0; i < lhs.size(); i++) {
+    result.call<void>("push", cc->EvalBinGate(gateVec[gateVec.size() == 1 ? 0 : i], lhs[i], rhs[i]));
+  }
+  return result;
+}
+
+/**
+ * @brief Evaluates NOT on every ciphertext of an array.
+ */
+emscripten::val EvalNOTs(const std::shared_ptr<BinFHEContext> &cc, const emscripten::val &ciphertexts) {
+  auto result = emscripten::val::array();
+  for (const auto &ct : vecFromJSArray<LWECiphertext>(ciphertexts)) {
+    result.call<void>("push", cc->EvalNOT(ct));
+  }
+  return result;
+}
+
+EMSCRIPTEN_BINDINGS(BinFHEContext) {
+  enum_<BINFHE_PARAMSET>("BINFHE_PARAMSET")
+      .value("TOY", TOY)
+      .value("MEDIUM", MEDIUM)
+      .value("STD128_AP", STD128_AP)
+      .value("STD128", STD128)
+      .value("STD128Q", STD128Q)
+      .value("STD192", STD192)
+      .value("STD192Q", STD192Q)
+      .value("STD256", STD256)
+      .value("STD256Q", STD256Q);
+
+  enum_<BINFHE_METHOD>("BINFHE_METHOD")
+      .value("AP", AP)
+      .value("GINX", GINX)
+      .value("LMKCDEY", LMKCDEY);
+
+  enum_<BINGATE>("BINGATE")
+      .value("OR", OR)
+      .value("AND", AND)
+      .value("NOR", NOR)
+      .value("NAND", NAND)
+      .value("XOR", XOR)
+      .value("XNOR", XNOR)
+      .value("XOR_FAST", XOR_FAST)
+      .value("XNOR_FAST", XNOR_FAST);
+
+  class_<LWEPrivateKeyImpl>("LWEPrivateKey")
+      .smart_ptr<LWEPrivateKey>("LWEPrivateKey");
+  class_<LWECiphertextImpl>("LWECiphertext")
+      .smart_ptr<LWECiphertext>("LWECiphertext");
+
+  class_<BinFHEContext>("BinFHEContext")
+      .smart_ptr<std::shared_ptr<BinFHEContext>>("BinFHEContext")
+      .constructor(&std::make_shared<BinFHEContext>, allow_raw_pointers())
+      .function("GenerateBinFHEContext",
+                select_overload<void(BINFHE_PARAMSET, BINFHE_METHOD)>(&BinFHEContext::GenerateBinFHEContext))
+      .function("KeyGen", &BinFHEContext::KeyGen)
+      .function("BTKeyGen", &BTKeyGen)
+      .function("Encrypt", &EncryptBit)
+      .function("Decrypt", &DecryptBit)
+      .function("EvalBinGate", &EvalBinGate)
+      .function("EvalNOT", &EvalNOT)
+      .function("Bootstrap", &Bootstrap)
+          // batched variants, one boundary crossing per call
+      .function("EncryptBits", &EncryptBits)
+      .function("DecryptBits", &DecryptBits)
+      .function("EvalBinGates", &EvalBinGates)
+      .function("EvalNOTs", &EvalNOTs)
+      .function("ClearBTKeys", &BinFHEContext::ClearBTKeys);
+}
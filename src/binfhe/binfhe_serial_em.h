@@ -0,0 +1,111 @@
+#ifndef _OPENFHEWEB_BINFHE_SERIAL_EM_H
+#define _OPENFHEWEB_BINFHE_SERIAL_EM_H
+
+#include "core/serial_em.h"
+using namespace lbcrypto;
+
+/**
+ * @brief Serialize a BinFHEContext (parameters only, no keys).
+ * @param cc - context to serialize.
+ * @param serType - #BINARY or #JSON
+ * @return serialized buffer.
+ */
+emscripten::val SerializeBinFHEContextToBuffer(const std::shared_ptr<BinFHEContext> &cc, JsSerType serType) {
+  return SerializeToBuffer(*cc, serType);
+}
+
+/**
+ * @brief Deserialize a BinFHEContext. The bootstrapping keys are loaded
+ * separately with BTKeyLoadFromBuffer().
+ * @param jsBuf - serialized context.
+ * @param serType - #BINARY or #JSON
+ * @return BinFHEContext.
+ */
+std::shared_ptr<BinFHEContext> DeserializeBinFHEContextFromBuffer(const emscripten::val &jsBuf, JsSerType serType) {
+  auto cc = std::make_shared<BinFHEContext>();
+  auto stream = typedArrayToStringstream(jsBuf);
+
+  if (serType == JsSerType::BINARY) {
+    Serial::Deserialize(*cc, stream, SerType::BINARY);
+  } else if (serType == JsSerType::JSON) {
+    Serial::Deserialize(*cc, stream, SerType::JSON);
+  }
+
+  return cc;
+}
+
+/**
+ * @brief Serialize one part of a length-prefixed record.
+ */
+template<typename T>
+void WriteFramed(std::ostream &os, const T &obj, JsSerType serType) {
+  std::ostringstream part;
+  if (serType == JsSerType::BINARY) {
+    Serial::Serialize(obj, part, SerType::BINARY);
+  } else {
+    Serial::Serialize(obj, part, SerType::JSON);
+  }
+  const auto str = part.str();
+  WriteRaw<uint64_t>(os, str.size());
+  os.write(str.data(), str.size());
+}
+
+/**
+ * @brief Deserialize a part written by WriteFramed().
+ */
+template<typename T>
+T ReadFramed(std::istream &is, JsSerType serType) {
+  std::string str(ReadRaw<uint64_t>(is), '\0');
+  if (!is.read(&str[0], str.size())) OPENFHE_THROW("unexpected end of buffer");
+  std::istringstream part(str);
+  T obj;
+  if (serType == JsSerType::BINARY) {
+    Serial::Deserialize(obj, part, SerType::BINARY);
+  } else {
+    Serial::Deserialize(obj, part, SerType::JSON);
+  }
+  return obj;
+}
+
+/**
+ * @brief Serialize the bootstrapping key (refresh key and key switching key)
+ * generated by BTKeyGen() into one buffer.
+ * @param cc - context holding the key.
+ * @param serType - #BINARY or #JSON
+ * @return serialized buffer.
+ */
+emscripten::val SerializeBTKeyToBuffer(const std::shared_ptr<BinFHEContext> &cc, JsSerType serType) {
+  if (!cc->GetRefreshKey() || !cc->GetSwitchingKey()) OPENFHE_THROW("no bootstrapping key, call BTKeyGen first");
+  std::ostringstream outputBuffer;
+  WriteFramed(outputBuffer, cc->GetRefreshKey(), serType);
+  WriteFramed(outputBuffer, cc->GetSwitchingKey(), serType);
+  return stringstreamToTypedArray(outputBuffer);
+}
+
+/**
+ * @brief Load a bootstrapping key written by SerializeBTKeyToBuffer(), so the
+ * context can evaluate gates without generating the key itself.
+ * @param cc - context with the parameters the key was generated for.
+ * @param jsBuf - serialized key.
+ * @param serType - #BINARY or #JSON
+ */
+void BTKeyLoadFromBuffer(const std::shared_ptr<BinFHEContext> &cc, const emscripten::val &jsBuf, JsSerType serType) {
+  auto stream = typedArrayToStringstream(jsBuf);
+  RingGSWBTKey key;
+  key.BSkey = ReadFramed<RingGSWACCKey>(stream, serType);
+  key.KSkey = ReadFramed<LWESwitchingKey>(stream, serType);
+  cc->BTKeyLoad(key);
+}
+
+EMSCRIPTEN_BINDINGS(binfhe_serial) {
+  emscripten::function("SerializeBinFHEContextToBuffer", &SerializeBinFHEContextToBuffer);
+  emscripten::function("DeserializeBinFHEContextFromBuffer", &DeserializeBinFHEContextFromBuffer);
+  emscripten::function("SerializeBTKeyToBuffer", &SerializeBTKeyToBuffer);
+  emscripten::function("BTKeyLoadFromBuffer", &BTKeyLoadFromBuffer);
+  emscripten::function("SerializeLWEPrivateKeyToBuffer", &SerializeToBuffer<LWEPrivateKey>);
+  emscripten::function("DeserializeLWEPrivateKeyFromBuffer", &DeserializeFromBuffer<LWEPrivateKey>);
+  emscripten::function("SerializeLWECiphertextToBuffer", &SerializeToBuffer<LWECiphertext>);
+  emscripten::function("DeserializeLWECiphertextFromBuffer", &DeserializeFromBuffer<LWECiphertext>);
+}
+
+#endif
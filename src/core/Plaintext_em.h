@@ -51,6 +51,31 @@ std::vector<int32_t> GetCoefPackedValue(Plaintext plaintext) {
   return retVec;
 }
 
+/**
+ * @brief Full-width packed values, without narrowing to int32.
+ * @return BigInt64Array.
+ */
+emscripten::val GetPackedValueInt64(Plaintext plaintext) {
+  return Int64VectorToTypedArray(plaintext->GetPackedValue());
+}
+
+/**
+ * @brief Full-width coefficient packed values, without narrowing to int32.
+ * @return BigInt64Array.
+ */
+emscripten::val GetCoefPackedValueInt64(Plaintext plaintext) {
+  return Int64VectorToTypedArray(plaintext->GetCoefPackedValue());
+}
+
+/**
+ * @brief Complex packed values of a CKKS plaintext.
+ * @param plaintext - input plaintext.
+ * @return interleaved re/im values as a Float64Array.
+ */
+emscripten::val GetComplexPackedValue(Plaintext plaintext) {
+  return ComplexVectorToTypedArray(plaintext->GetCKKSPackedValue());
+}
+
 EMSCRIPTEN_BINDINGS(core) {
   class_<PlaintextImpl>("Plaintext")
       .smart_ptr<Plaintext>("Plaintext")
@@ -60,7 +85,10 @@ EMSCRIPTEN_BINDINGS(core) {
       .function("toString", &GetString<PlaintextImpl>)
       .function("GetPackedValue", &GetPackedValue)
       .function("GetCoefPackedValue", &GetCoefPackedValue)
-      .function("GetRealPackedValue", &PlaintextImpl::GetRealPackedValue);
+      .function("GetPackedValueInt64", &GetPackedValueInt64)
+      .function("GetCoefPackedValueInt64", &GetCoefPackedValueInt64)
+      .function("GetRealPackedValue", &PlaintextImpl::GetRealPackedValue)
+      .function("GetComplexPackedValue", &GetComplexPackedValue);
 
   // Enumerations
   enum_<SecurityLevel>("SecurityLevel")
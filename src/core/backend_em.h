@@ -4,16 +4,27 @@
 
 #include <string>
 
-#if NATIVEINT == 64
-std::string m_BackendSize = "64";
-#else  // NATIVEINT == 128
+#if NATIVEINT == 128
 std::string m_BackendSize = "128";
+#elif NATIVEINT == 32
+// 32-bit words: RNS moduli of at most MAX_MODULUS_SIZE (28) bits, so modular
+// products fit into a wasm i64 instead of an emulated 128-bit product.
+std::string m_BackendSize = "32";
+#else  // NATIVEINT == 64
+std::string m_BackendSize = "64";
 #endif
 
 std::string GetBackendSize() { return m_BackendSize; }
 
+/**
+ * @brief Largest RNS modulus size supported by the native backend.
+ * @return bits; ScalingModSize and FirstModSize must not exceed it.
+ */
+uint32_t GetMaxModulusSize() { return MAX_MODULUS_SIZE; }
+
 EMSCRIPTEN_BINDINGS(backend) {
   emscripten::function("GetBackendSize", &GetBackendSize);
+  emscripten::function("GetMaxModulusSize", &GetMaxModulusSize);
 };
 
 #endif  // BACKEND_EM_H
@@ -0,0 +1,85 @@
+#ifndef _OPENFHEWEB_CORE_BITPACK_H_
+#define _OPENFHEWEB_CORE_BITPACK_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+// Helpers to write and read unsigned values of a fixed bit width into a byte
+// string, least significant bit first, without padding between values.
+
+class BitWriter {
+ public:
+  explicit BitWriter(std::string &out) : m_out(out) {}
+
+  void Write(uint64_t value, uint32_t bits) {
+    while (bits > 0) {
+      const uint32_t take = std::min<uint32_t>(bits, 64 - m_used);
+      const uint64_t mask = take == 64 ? ~0ULL : ((1ULL << take) - 1);
+      m_acc |= (value & mask) << m_used;
+      m_used += take;
+      value = take == 64 ? 0 : value >> take;
+      bits -= take;
+      if (m_used == 64) FlushWord();
+    }
+  }
+
+  // write out the last partial byte
+  void Flush() {
+    while (m_used > 0) {
+      m_out.push_back(static_cast<char>(m_acc & 0xff));
+      m_acc >>= 8;
+      m_used = m_used > 8 ? m_used - 8 : 0;
+    }
+    m_acc = 0;
+  }
+
+ private:
+  void FlushWord() {
+    for (int i = 0; i < 8; i++) m_out.push_back(static_cast<char>((m_acc >> (8 * i)) & 0xff));
+    m_acc = 0;
+    m_used = 0;
+  }
+
+  std::string &m_out;
+  uint64_t m_acc = 0;
+  uint32_t m_used = 0;
+};
+
+class BitReader {
+ public:
+  BitReader(const uint8_t *data, size_t size) : m_data(data), m_size(size) {}
+
+  uint64_t Read(uint32_t bits) {
+    uint64_t value = 0;
+    uint32_t filled = 0;
+    while (filled < bits) {
+      if (m_available == 0) {
+        if (m_pos >= m_size) throw std::runtime_error("bit stream is truncated");
+        m_acc = m_data[m_pos++];
+        m_available = 8;
+      }
+      const uint32_t take = std::min(bits - filled, m_available);
+      value |= (m_acc & ((1ULL << take) - 1)) << filled;
+      m_acc >>= take;
+      m_available -= take;
+      filled += take;
+    }
+    return value;
+  }
+
+  // skip the rest of the current byte
+  void Align() { m_available = 0; }
+
+  size_t BytesConsumed() const { return m_pos; }
+
+ private:
+  const uint8_t *m_data;
+  size_t m_size;
+  size_t m_pos = 0;
+  uint64_t m_acc = 0;
+  uint32_t m_available = 0;
+};
+
+#endif
@@ -8,8 +8,26 @@ void ReleaseAllContexts() {
   lbcrypto::CryptoContextFactory<lbcrypto::DCRTPoly>::ReleaseAllContexts();
 }
 
+/**
+ * Clears the relinearization, rotation and sum keys of every key tag.
+ */
+void ClearAllEvalKeys() {
+  lbcrypto::CryptoContextImpl<lbcrypto::DCRTPoly>::ClearEvalMultKeys();
+  lbcrypto::CryptoContextImpl<lbcrypto::DCRTPoly>::ClearEvalAutomorphismKeys();
+}
+
+/**
+ * Clears the relinearization, rotation and sum keys of one key tag.
+ */
+void ClearEvalKeysForTag(const std::string &keyTag) {
+  lbcrypto::CryptoContextImpl<lbcrypto::DCRTPoly>::ClearEvalMultKeys(keyTag);
+  lbcrypto::CryptoContextImpl<lbcrypto::DCRTPoly>::ClearEvalAutomorphismKeys(keyTag);
+}
+
 EMSCRIPTEN_BINDINGS(clear_contexts) {
   emscripten::function("ReleaseAllContexts", &ReleaseAllContexts);
+  emscripten::function("ClearAllEvalKeys", &ClearAllEvalKeys);
+  emscripten::function("ClearEvalKeysForTag", &ClearEvalKeysForTag);
 };
 
 #endif  // CLEAR_CONTEXT_H
@@ -0,0 +1,32 @@
+
+#ifndef MEMORY_EM_H
+#define MEMORY_EM_H
+
+#include <malloc.h>
+#include <emscripten/heap.h>
+
+/**
+ * @brief Number of bytes currently allocated on the WASM heap.
+ * @return bytes in use by live allocations.
+ */
+double GetHeapInUse() {
+#ifdef __EMSCRIPTEN__
+  return mallinfo().uordblks;
+#else
+  // mallinfo() counts in int and wraps past 2 GiB; glibc 2.33 added mallinfo2()
+  return mallinfo2().uordblks;
+#endif
+}
+
+/**
+ * @brief Current size of the WASM linear memory.
+ * @return bytes reserved by the module, including free space.
+ */
+double GetHeapSize() { return emscripten_get_heap_size(); }
+
+EMSCRIPTEN_BINDINGS(memory) {
+  emscripten::function("GetHeapInUse", &GetHeapInUse);
+  emscripten::function("GetHeapSize", &GetHeapSize);
+};
+
+#endif  // MEMORY_EM_H
@@ -1,6 +1,10 @@
 #ifndef _OPENFHEWEB_CORE_OPENFHE_EM_H
 #define _OPENFHEWEB_CORE_OPENFHE_EM_H
 
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
 #include "core/serial_em.h"
 
 std::vector<int64_t> MakeVectorInt64Clipped(const emscripten::val &val) {
@@ -8,12 +12,97 @@ std::vector<int64_t> MakeVectorInt64Clipped(const emscripten::val &val) {
   return std::vector<int64_t>(vec32.begin(), vec32.end());
 }
 
+/**
+ * @brief Convert a JS Number to an integer, rejecting Numbers that are not
+ * integers or lie beyond 2^53, where they stop being exact.
+ */
+int64_t Int64FromNumber(double value) {
+  if (!std::isfinite(value) || std::trunc(value) != value || std::fabs(value) > 9007199254740991.0) {
+    OPENFHE_THROW("not an integer Number up to 2^53 (pass larger values as BigInt): " + std::to_string(value));
+  }
+  return static_cast<int64_t>(value);
+}
+
+/**
+ * @brief Convert JS integers to int64 values without clipping.
+ * @param values - BigInt64Array or BigUint64Array, copied in bulk, or an
+ * array of integer Numbers up to 2^53; other Numbers are rejected.
+ * @return vector of the values.
+ */
+std::vector<int64_t> MakeVectorInt64(const emscripten::val &values) {
+  const auto length = values["length"].as<size_t>();
+  const auto type = values["constructor"]["name"].as<std::string>();
+  std::vector<int64_t> vec(length);
+  if (type == "BigInt64Array" || type == "BigUint64Array") {
+    val memoryView(emscripten::typed_memory_view(length, vec.data()));
+    memoryView.call<void>("set", values);
+  } else {
+    const auto doubles = convertJSArrayToNumberVector<double>(values);
+    std::transform(doubles.begin(), doubles.end(), vec.begin(), &Int64FromNumber);
+  }
+  return vec;
+}
+
+/**
+ * @brief Copy int64 values into a new BigInt64Array.
+ */
+emscripten::val Int64VectorToTypedArray(const std::vector<int64_t> &vec) {
+  return val::global("BigInt64Array").new_(emscripten::typed_memory_view(vec.size(), vec.data()));
+}
+
+/**
+ * @brief Read an unsigned 64-bit value passed as a BigInt or a Number.
+ */
+uint64_t Uint64FromJS(const emscripten::val &value) {
+  if (value.typeOf().as<std::string>() == "bigint") return value.as<uint64_t>();
+  const auto number = Int64FromNumber(value.as<double>());
+  if (number < 0) OPENFHE_THROW("expected a non-negative integer");
+  return static_cast<uint64_t>(number);
+}
+
+/**
+ * @brief Return an unsigned 64-bit value as a BigInt.
+ */
+emscripten::val Uint64ToBigInt(uint64_t value) {
+  return val::global("BigUint64Array").new_(emscripten::typed_memory_view(1, &value))[0];
+}
+
+/**
+ * @brief Convert interleaved re/im values to complex numbers.
+ * @param values - Float64Array, copied in bulk, or array of Numbers.
+ * @return vector of complex values, half the input length.
+ */
+std::vector<std::complex<double>> MakeVectorComplex(const emscripten::val &values) {
+  const auto length = values["length"].as<size_t>();
+  if (length % 2) OPENFHE_THROW("interleaved complex values must have an even length");
+
+  std::vector<std::complex<double>> vec(length / 2);
+  const auto data = reinterpret_cast<double *>(vec.data());
+  if (values["constructor"]["name"].as<std::string>() == "Float64Array") {
+    val memoryView(emscripten::typed_memory_view(length, data));
+    memoryView.call<void>("set", values);
+  } else {
+    const auto doubles = convertJSArrayToNumberVector<double>(values);
+    std::copy(doubles.begin(), doubles.end(), data);
+  }
+  return vec;
+}
+
+/**
+ * @brief Copy complex values into a new interleaved Float64Array.
+ */
+emscripten::val ComplexVectorToTypedArray(const std::vector<std::complex<double>> &vec) {
+  const auto data = reinterpret_cast<const double *>(vec.data());
+  return val::global("Float64Array").new_(emscripten::typed_memory_view(2 * vec.size(), data));
+}
+
 EMSCRIPTEN_BINDINGS(core_types) {
   register_vector<int32_t>("VectorInt32").constructor(&convertJSArrayToNumberVector<int32_t>);
   emscripten::function("MakeVectorInt32", &convertJSArrayToNumberVector<int32_t>);
 
   register_vector<int64_t>("VectorInt64");
   emscripten::function("MakeVectorInt64Clipped", &MakeVectorInt64Clipped);
+  emscripten::function("MakeVectorInt64", &MakeVectorInt64);
 
   register_vector<double>("VectorDouble").constructor(&convertJSArrayToNumberVector<double>);
 
@@ -36,31 +36,39 @@
 #ifndef OPENFHE_WASM_SRC_CORE_PARAMETERS_H_
 #define OPENFHE_WASM_SRC_CORE_PARAMETERS_H_
 
+#include "core/openfhe_em.h"
 #include "core/wrapped.h"
 #include "openfhe.h"
 
 /**
  * @brief Getter for the plaintext modulus.
  * @param CryptoParameters -
- * @return The plaintext modulus.
+ * @return The plaintext modulus as a Number, exact up to 2^53.
  */
 template<typename Element>
-uint32_t GetWrappedPlaintextModulus(const CCParams<Element> &CryptoParameters) {
-  // assume that the plaintext modulus is < 2^31
-  return (uint32_t) CryptoParameters.GetPlaintextModulus();
+double GetWrappedPlaintextModulus(const CCParams<Element> &CryptoParameters) {
+  return static_cast<double>(CryptoParameters.GetPlaintextModulus());
+}
+
+/**
+ * @brief Getter for the plaintext modulus.
+ * @param CryptoParameters -
+ * @return The plaintext modulus as a BigInt.
+ */
+template<typename Element>
+emscripten::val GetPlaintextModulusBigInt(const CCParams<Element> &CryptoParameters) {
+  return Uint64ToBigInt(CryptoParameters.GetPlaintextModulus());
 }
 
 /**
  * @brief Setter for the plaintext modulus.
  * @param CryptoParameters -
- * @return The plaintext modulus.
+ * @param ptMod - plaintext modulus as a Number or, above 2^53, a BigInt.
  */
 template<typename Scheme>
 void SetWrappedPlaintextModulus(
     CCParams<Scheme> &CryptoParameters, const emscripten::val &ptMod) {
-  // assume that the plaintext modulus is < 2^31
-  const auto as32t = ptMod.as<uint32_t>();
-  CryptoParameters.SetPlaintextModulus(as32t);
+  CryptoParameters.SetPlaintextModulus(Uint64FromJS(ptMod));
 }
 
 /**
@@ -111,6 +119,14 @@ void SetScalingModSize(
   CryptoParameters.SetScalingModSize(scalingModSize);
 }
 
+template<typename Scheme>
+void SetFirstModSize(
+    CCParams<Scheme> &CryptoParameters,
+    usint firstModSize
+) {
+  CryptoParameters.SetFirstModSize(firstModSize);
+}
+
 template<typename Scheme>
 void SetBatchSize(
     CCParams<Scheme> &CryptoParameters,
@@ -187,12 +203,36 @@ void SetEvalAddCount(
   CryptoParameters.SetEvalAddCount(eaCount);
 }
 
+template<typename Scheme>
+void SetNumLargeDigits(
+    CCParams<Scheme> &CryptoParameters,
+    uint32_t numLargeDigits
+) {
+  CryptoParameters.SetNumLargeDigits(numLargeDigits);
+}
+template<typename Scheme>
+void SetMultiplicationTechnique(
+    CCParams<Scheme> &CryptoParameters,
+    MultiplicationTechnique mt
+) {
+  CryptoParameters.SetMultiplicationTechnique(mt);
+}
+template<typename Scheme>
+void SetEncryptionTechnique(
+    CCParams<Scheme> &CryptoParameters,
+    EncryptionTechnique et
+) {
+  CryptoParameters.SetEncryptionTechnique(et);
+}
+
 using CKKS = CryptoContextCKKSRNS;
 using CCP_CKKS = CCParams<CKKS>;
 using BFV = CryptoContextBFVRNS;
 using CCP_BFV = CCParams<BFV>;
 using BGV = CryptoContextBGVRNS;
 using CCP_BGV = CCParams<BGV>;
+// slim client modules (src/pke/client_em.cpp) bind the parameters of their scheme only
+#ifndef OPENFHEWEB_SLIM_CLIENT
 EMSCRIPTEN_BINDINGS(parameters) {
 
   // Enumerations
@@ -201,21 +241,37 @@ EMSCRIPTEN_BINDINGS(parameters) {
       .value("FIXED_NOISE_MULTIPARTY", FIXED_NOISE_MULTIPARTY)
       .value("NOISE_FLOODING_MULTIPARTY", NOISE_FLOODING_MULTIPARTY);
 
+  // BFV only
+  enum_<MultiplicationTechnique>("MultiplicationTechnique")
+      .value("BEHZ", BEHZ)
+      .value("HPS", HPS)
+      .value("HPSPOVERQ", HPSPOVERQ)
+      .value("HPSPOVERQLEVELED", HPSPOVERQLEVELED);
+
+  enum_<EncryptionTechnique>("EncryptionTechnique")
+      .value("STANDARD", STANDARD)
+      .value("EXTENDED", EXTENDED);
+
   class_<CCP_BFV>("CCParamsCryptoContextBFVRNS")
       .smart_ptr<std::shared_ptr<CCP_BFV>>("CCParamsCryptoContextBFVRNS")
       .constructor(&std::make_shared<CCP_BFV>, allow_raw_pointers())
       .function("GetPlaintextModulus", &GetWrappedPlaintextModulus<BFV>)
+      .function("GetPlaintextModulusBigInt", &GetPlaintextModulusBigInt<BFV>)
       .function("SetPlaintextModulus", &SetWrappedPlaintextModulus<BFV>)
       .function("GetMultiplicativeDepth", &GetWrappedMultiplicativeDepth<BFV>)
       .function("SetMultiplicativeDepth", &SetWrappedMultiplicativeDepth<BFV>)
       .function("SetSecurityLevel", &SetSecurityLevel<BFV>)
       .function("SetRingDim", &SetRingDim<BFV>)
       .function("SetScalingModSize", &SetScalingModSize<BFV>)
+      .function("SetFirstModSize", &SetFirstModSize<BFV>)
       .function("SetBatchSize", &SetBatchSize<BFV>)
       .function("SetScalingTechnique", &SetScalingTechnique<BFV>)
       .function("SetKeySwitchTechnique", &SetKeySwitchTechnique<BFV>)
       .function("SetMultipartyMode", &SetMultipartyMode<BFV>)
       .function("SetDigitSize", &SetDigitSize<BFV>)
+      .function("SetNumLargeDigits", &SetNumLargeDigits<BFV>)
+      .function("SetMultiplicationTechnique", &SetMultiplicationTechnique<BFV>)
+      .function("SetEncryptionTechnique", &SetEncryptionTechnique<BFV>)
       .function("SetStandardDeviation", &SetStandardDeviation<BFV>)
       .function("SetSecretKeyDist", &SetSecretKeyDist<BFV>)
       .function("SetMaxRelinSkDeg", &SetMaxRelinSkDeg<BFV>)
@@ -227,18 +283,21 @@ EMSCRIPTEN_BINDINGS(parameters) {
       .smart_ptr<std::shared_ptr<CCP_BGV>>("CCParamsCryptoContextBGVRNS")
       .constructor(&std::make_shared<CCP_BGV>, allow_raw_pointers())
       .function("GetPlaintextModulus", &GetWrappedPlaintextModulus<BGV>)
+      .function("GetPlaintextModulusBigInt", &GetPlaintextModulusBigInt<BGV>)
       .function("SetPlaintextModulus", &SetWrappedPlaintextModulus<BGV>)
       .function("GetMultiplicativeDepth", &GetWrappedMultiplicativeDepth<BGV>)
       .function("SetMultiplicativeDepth", &SetWrappedMultiplicativeDepth<BGV>)
       .function("SetSecurityLevel", &SetSecurityLevel<BGV>)
       .function("SetRingDim", &SetRingDim<BGV>)
       .function("SetScalingModSize", &SetScalingModSize<BGV>)
+      .function("SetFirstModSize", &SetFirstModSize<BGV>)
       .function("SetBatchSize", &SetBatchSize<BGV>)
       .function("SetScalingTechnique", &SetScalingTechnique<BGV>)
       .function("SetKeySwitchTechnique", &SetKeySwitchTechnique<BGV>)
       .function("SetMultipartyMode", &SetMultipartyMode<BGV>)
 
       .function("SetDigitSize", &SetDigitSize<BGV>)
+      .function("SetNumLargeDigits", &SetNumLargeDigits<BGV>)
       .function("SetStandardDeviation", &SetStandardDeviation<BGV>)
       .function("SetSecretKeyDist", &SetSecretKeyDist<BGV>)
       .function("SetMaxRelinSkDeg", &SetMaxRelinSkDeg<BGV>)
@@ -250,17 +309,20 @@ EMSCRIPTEN_BINDINGS(parameters) {
       .smart_ptr<std::shared_ptr<CCP_CKKS>>("CCParamsCryptoContextCKKSRNS")
       .constructor(&std::make_shared<CCP_CKKS>, allow_raw_pointers())
       .function("GetPlaintextModulus", &GetWrappedPlaintextModulus<CKKS>)
+      .function("GetPlaintextModulusBigInt", &GetPlaintextModulusBigInt<CKKS>)
       .function("SetPlaintextModulus", &SetWrappedPlaintextModulus<CKKS>)
       .function("GetMultiplicativeDepth", &GetWrappedMultiplicativeDepth<CKKS>)
       .function("SetMultiplicativeDepth", &SetWrappedMultiplicativeDepth<CKKS>)
       .function("SetSecurityLevel", &SetSecurityLevel<CKKS>)
       .function("SetRingDim", &SetRingDim<CKKS>)
       .function("SetScalingModSize", &SetScalingModSize<CKKS>)
+      .function("SetFirstModSize", &SetFirstModSize<CKKS>)
       .function("SetBatchSize", &SetBatchSize<CKKS>)
       .function("SetScalingTechnique", &SetScalingTechnique<CKKS>)
       .function("SetKeySwitchTechnique", &SetKeySwitchTechnique<CKKS>)
       .function("SetMultipartyMode", &SetMultipartyMode<CKKS>)
       .function("SetDigitSize", &SetDigitSize<CKKS>)
+      .function("SetNumLargeDigits", &SetNumLargeDigits<CKKS>)
       .function("SetStandardDeviation", &SetStandardDeviation<CKKS>)
       .function("SetSecretKeyDist", &SetSecretKeyDist<CKKS>)
       .function("SetMaxRelinSkDeg", &SetMaxRelinSkDeg<CKKS>)
@@ -268,5 +330,6 @@ EMSCRIPTEN_BINDINGS(parameters) {
       .function("SetEvalAddCount", &SetEvalAddCount<CKKS>)
       .function("toString", &GetString<CCP_CKKS>);
 }
+#endif
 
 #endif //OPENFHE_WASM_SRC_CORE_PARAMETERS_H_
@@ -12,9 +12,42 @@ emscripten::val stringstreamToTypedArray(std::ostringstream &ss) {
   return val::global("Uint8Array").new_(emscripten::typed_memory_view(str.length(), str.c_str()));
 }
 
+/**
+ * @brief Copy a JS Uint8Array into a string with a single bulk copy.
+ * @param jsBuf - input Uint8Array.
+ * @return string holding the same bytes.
+ */
+std::string typedArrayToString(const emscripten::val &jsBuf) {
+  const auto length = jsBuf["length"].as<size_t>();
+  std::string str(length, '\0');
+  val memoryView(emscripten::typed_memory_view(length, reinterpret_cast<uint8_t *>(&str[0])));
+  memoryView.call<void>("set", jsBuf);
+  return str;
+}
+
 std::istringstream typedArrayToStringstream(const emscripten::val &jsBuf) {
-  auto buf = emscripten::vecFromJSArray<uint8_t>(jsBuf);
-  return std::istringstream(std::string(buf.begin(), buf.end()));
+  return std::istringstream(typedArrayToString(jsBuf));
+}
+
+/**
+ * @brief Write a trivially copyable value in host (little endian) byte order.
+ * Used by the compact binary formats that do not go through cereal.
+ */
+template<typename T>
+void WriteRaw(std::ostream &os, const T &value) {
+  os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+ * @brief Read a value written by WriteRaw().
+ */
+template<typename T>
+T ReadRaw(std::istream &is) {
+  T value;
+  if (!is.read(reinterpret_cast<char *>(&value), sizeof(T))) {
+    OPENFHE_THROW("unexpected end of buffer");
+  }
+  return value;
 }
 
 /**
@@ -0,0 +1,210 @@
+#ifndef _OPENFHEWEB_CORE_TRACE_EM_H
+#define _OPENFHEWEB_CORE_TRACE_EM_H
+
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <emscripten.h>
+
+// Opt-in timeline tracing in the Chrome trace_event format.
+//
+// Every traced binding call records a complete ("X") event with its start
+// and duration; operations the bindings compose themselves, such as the
+// rotation steps of a planned rotation or the relinearization of a sum of
+// products, record nested events of category "openfhe" inside it. Work done
+// within a single OpenFHE call (its NTTs, the key switch inside EvalMult) is
+// not visible at this level and shows up as the binding's own time.
+//
+// While tracing is off a span costs one branch on a global flag.
+
+struct TraceEvent {
+  const char *name;
+  const char *category;
+  double start;     // emscripten_get_now() milliseconds
+  double duration;  // milliseconds
+};
+
+struct TraceState {
+  bool enabled = false;
+  size_t maxEvents = 0;
+  size_t dropped = 0;
+  std::vector<TraceEvent> events;
+};
+
+inline TraceState &GetTraceState() {
+  static TraceState state;
+  return state;
+}
+
+/**
+ * @brief Records the lifetime of a scope as a trace event when tracing is on.
+ */
+class TraceSpan {
+ public:
+  explicit TraceSpan(const char *name, const char *category = "binding") {
+    if (!GetTraceState().enabled) return;
+    m_name = name;
+    m_category = category;
+    m_start = emscripten_get_now();
+  }
+
+  ~TraceSpan() {
+    if (m_name == nullptr) return;
+    const double end = emscripten_get_now();
+    auto &state = GetTraceState();
+    if (state.events.size() < state.maxEvents) {
+      state.events.push_back({m_name, m_category, m_start, end - m_start});
+    } else {
+      state.dropped++;
+    }
+  }
+
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+
+ private:
+  const char *m_name = nullptr;
+  const char *m_category = nullptr;
+  double m_start = 0;
+};
+
+// Work a module defers until a binding first uses an object, such as the CRT
+// tables of a context deserialized with CRTPrecomputePolicy::LAZY (see
+// context_cache_em.h). Traced bindings pass the hook the object of a member
+// call, or what the first argument of a free call points to. The hook is only
+// set while such work is pending.
+using FirstUseHook = void (*)(const void *object);
+
+inline FirstUseHook &GetFirstUseHook() {
+  static FirstUseHook hook = nullptr;
+  return hook;
+}
+
+template<typename T>
+const void *GetBindingObject(const T &) { return nullptr; }
+
+template<typename T>
+const void *GetBindingObject(const std::shared_ptr<T> &object) { return object.get(); }
+
+template<typename T>
+const void *GetBindingObject(T *object) { return object; }
+
+template<typename... Args>
+void RunFirstUseHook(const Args &...args) {
+  if constexpr (sizeof...(Args) > 0) {
+    const auto hook = GetFirstUseHook();
+    if (hook != nullptr) hook(GetBindingObject(std::get<0>(std::tie(args...))));
+  }
+}
+
+/**
+ * @brief Binding wrapper recording a span around a free or member function
+ * and running the first-use hook. Bind Traced<&Fn>("Name") in place of &Fn;
+ * the JS signature is unchanged.
+ */
+template<auto Fn, typename F = decltype(Fn)>
+struct TracedCall;
+
+template<auto Fn, typename R, typename... Args>
+struct TracedCall<Fn, R (*)(Args...)> {
+  static inline const char *name = "";
+  static R Call(Args... args) {
+    TraceSpan span(name);
+    RunFirstUseHook(args...);
+    return Fn(std::forward<Args>(args)...);
+  }
+};
+
+template<auto Fn, typename R, typename C, typename... Args>
+struct TracedCall<Fn, R (C::*)(Args...)> {
+  static inline const char *name = "";
+  static R Call(C &self, Args... args) {
+    TraceSpan span(name);
+    RunFirstUseHook(&self);
+    return (self.*Fn)(std::forward<Args>(args)...);
+  }
+};
+
+template<auto Fn, typename R, typename C, typename... Args>
+struct TracedCall<Fn, R (C::*)(Args...) const> {
+  static inline const char *name = "";
+  static R Call(const C &self, Args... args) {
+    TraceSpan span(name);
+    RunFirstUseHook(&self);
+    return (self.*Fn)(std::forward<Args>(args)...);
+  }
+};
+
+template<auto Fn>
+auto Traced(const char *name) {
+  TracedCall<Fn>::name = name;
+  return &TracedCall<Fn>::Call;
+}
+
+/**
+ * @brief Start recording, discarding earlier events.
+ * @param maxEvents - events kept; later ones are counted as dropped.
+ */
+void StartTracing(uint32_t maxEvents) {
+  auto &state = GetTraceState();
+  state.events.clear();
+  state.events.reserve(maxEvents);
+  state.maxEvents = maxEvents;
+  state.dropped = 0;
+  state.enabled = true;
+}
+
+void StopTracing() { GetTraceState().enabled = false; }
+
+bool IsTracing() { return GetTraceState().enabled; }
+
+/**
+ * @brief Current value of the clock the events are recorded with.
+ * Lets JS map event times onto another clock, e.g. process.hrtime().
+ */
+double GetTraceClock() { return emscripten_get_now(); }
+
+uint32_t GetTraceDroppedEvents() { return GetTraceState().dropped; }
+
+void ClearTrace() {
+  auto &state = GetTraceState();
+  state.events.clear();
+  state.dropped = 0;
+}
+
+/**
+ * @brief Recorded events as a Chrome trace_event JSON document.
+ * @param offsetUs - added to every timestamp, in microseconds.
+ * @param pid - process id the events are attributed to.
+ * @return JSON loadable in Perfetto or chrome://tracing.
+ */
+std::string ExportTraceJSON(double offsetUs, uint32_t pid) {
+  std::ostringstream json;
+  json << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  const auto &events = GetTraceState().events;
+  for (size_t i = 0; i < events.size(); i++) {
+    const auto &event = events[i];
+    json << (i ? "," : "") << "{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+         << "\",\"ph\":\"X\",\"ts\":" << event.start * 1000 + offsetUs << ",\"dur\":" << event.duration * 1000
+         << ",\"pid\":" << pid << ",\"tid\":" << pid << "}";
+  }
+  json << "]}";
+  return json.str();
+}
+
+EMSCRIPTEN_BINDINGS(trace) {
+  emscripten::function("StartTracing", &StartTracing);
+  emscripten::function("StopTracing", &StopTracing);
+  emscripten::function("IsTracing", &IsTracing);
+  emscripten::function("GetTraceClock", &GetTraceClock);
+  emscripten::function("GetTraceDroppedEvents", &GetTraceDroppedEvents);
+  emscripten::function("ClearTrace", &ClearTrace);
+  emscripten::function("ExportTraceJSON", &ExportTraceJSON);
+}
+
+#endif
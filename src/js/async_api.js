@@ -0,0 +1,173 @@
+// Promise-based variants of the long-running key generation calls.
+//
+// This file is appended to the generated module with --post-js; the native
+// addon's loader (src/napi/openfhe_pke_native.js) evaluates it the same way.
+//
+// KeyGenAsync, EvalMultKeyGenAsync and EvalSumKeyGenAsync are single OpenFHE
+// calls that cannot be split. In nodejs they run in a worker_thread on a
+// second instance of the module, which returns the serialized keys; this
+// instance only deserializes them. Elsewhere (browsers, the ES6 module and
+// the native addon, which cannot be loaded twice) they run on the calling
+// thread. EvalAtIndexKeyGenAsync splits the rotations into chunks on the
+// calling thread and yields to the event loop between chunks, so timers, I/O
+// and health checks keep being served.
+//
+// Every *Async method takes an optional options object:
+//   onProgress(done, total) - called after each chunk.
+//   signal                  - an AbortSignal; aborting rejects the Promise
+//                             before the next chunk starts, or terminates
+//                             the worker. Keys generated by earlier chunks
+//                             stay in the context.
+//   chunkSize               - rotation keys generated per chunk (default 4).
+
+async function runChunked(chunks, options) {
+    const {onProgress, signal} = options || {};
+    const total = chunks.reduce((sum, chunk) => sum + chunk.size, 0);
+    let done = 0;
+    let result;
+    for (const chunk of chunks) {
+        await yieldToEventLoop();
+        throwIfAborted(signal);
+        result = chunk.run();
+        done += chunk.size;
+        if (onProgress) onProgress(done, total);
+    }
+    return result;
+}
+
+// Body of the key generation worker. It is started from its source text, so
+// it must not refer to anything outside itself.
+function keyGenWorkerMain() {
+    const {parentPort, workerData} = require('worker_threads');
+    const {modulePath, wasmModule, job, context, secretKey} = workerData;
+    require(modulePath)({
+        instantiateWasm: (imports, receiveInstance) => {
+            WebAssembly.instantiate(wasmModule, imports).then(instance => receiveInstance(instance, wasmModule));
+            return {};  // instantiated asynchronously
+        },
+    }).then(Module => {
+        const BINARY = Module['SerType']['BINARY'];
+        const handles = [];
+        const keep = handle => (handles.push(handle), handle);
+        try {
+            const cc = keep(Module['DeserializeCryptoContextFromBuffer'](context, BINARY));
+            ['PKE', 'KEYSWITCH', 'LEVELEDSHE', 'ADVANCEDSHE'].forEach(
+                feature => cc['Enable'](Module['PKESchemeFeature'][feature]));
+            let reply;
+            if (job === 'KeyGen') {
+                const keyPair = keep(cc['KeyGen']());
+                reply = {
+                    publicKey: Module['SerializePublicKeyToBuffer'](keep(keyPair['publicKey']), BINARY),
+                    secretKey: Module['SerializePrivateKeyToBuffer'](keep(keyPair['secretKey']), BINARY),
+                };
+            } else {
+                const privateKey = keep(Module['DeserializePrivateKeyFromBuffer'](secretKey, BINARY));
+                const keyTag = privateKey['GetKeyTag']();
+                if (job === 'EvalMultKeyGen') {
+                    cc['EvalMultKeyGen'](privateKey);
+                    reply = {keys: cc['SerializeEvalMultKeyForTagToBuffer'](keyTag, BINARY)};
+                } else {
+                    cc['EvalSumKeyGen'](privateKey);
+                    reply = {keys: cc['SerializeEvalSumKeyForTagToBuffer'](keyTag, BINARY)};
+                }
+            }
+            parentPort.postMessage(reply, Object.values(reply).map(bytes => bytes.buffer));
+        } catch (error) {
+            const message = typeof error === 'number' ? Module['getExceptionMessage'](error) : error.message;
+            parentPort.postMessage({error: String(message)});
+        } finally {
+            handles.forEach(handle => handle.delete());
+        }
+    });
+}
+
+addOnPostRun(() => {
+    const proto = Module['CryptoContext_DCRTPoly'].prototype;
+    const BINARY = () => Module['SerType']['BINARY'];
+
+    // the CommonJS build in nodejs knows its own file, which the worker loads
+    const useWorker = !Module['native'] && typeof require === 'function' && typeof __filename === 'string' &&
+        typeof process === 'object' && !!(process.versions && process.versions.node);
+    let wasmModule;  // Promise of the compiled .wasm, shared by all workers
+
+    // Runs one key generation job in a new worker and resolves to its reply.
+    function runInWorker(workerData, options) {
+        const {onProgress, signal} = options || {};
+        if (!wasmModule) {
+            wasmModule = require('fs').promises.readFile(__filename.replace(/\.js$/, '.wasm'))
+                .then(bytes => WebAssembly.compile(bytes));
+        }
+        return wasmModule.then(compiled => new Promise((resolve, reject) => {
+            throwIfAborted(signal);
+            const {Worker} = require('worker_threads');
+            const worker = new Worker(`(${keyGenWorkerMain})()`, {
+                eval: true,
+                workerData: Object.assign({modulePath: __filename, wasmModule: compiled}, workerData),
+            });
+            const onAbort = () => {
+                worker.terminate();
+                reject(signal.reason !== undefined ? signal.reason : new Error('Aborted'));
+            };
+            if (signal) signal.addEventListener('abort', onAbort, {once: true});
+            const settle = (settleFn, value) => {
+                if (signal) signal.removeEventListener('abort', onAbort);
+                settleFn(value);
+            };
+            worker.once('message', reply => {
+                worker.terminate();
+                if (reply.error !== undefined) {
+                    settle(reject, new Error(reply.error));
+                    return;
+                }
+                if (onProgress) onProgress(1, 1);
+                settle(resolve, reply);
+            });
+            worker.once('error', error => settle(reject, error));
+            // a no-op once the reply has settled the Promise
+            worker.once('exit', code => settle(reject, new Error('key generation worker exited with code ' + code)));
+        }));
+    }
+
+    function contextBytes(cc) {
+        return Module['SerializeCryptoContextToBuffer'](cc, BINARY());
+    }
+
+    proto['KeyGenAsync'] = function (options) {
+        if (!useWorker) return runChunked([{size: 1, run: () => this.KeyGen()}], options);
+        return runInWorker({job: 'KeyGen', context: contextBytes(this)}, options).then(reply => {
+            const publicKey = Module['DeserializePublicKeyFromBuffer'](reply.publicKey, BINARY());
+            const secretKey = Module['DeserializePrivateKeyFromBuffer'](reply.secretKey, BINARY());
+            const keyPair = new Module['KeyPair_DCRTPoly'](publicKey, secretKey);
+            publicKey.delete();
+            secretKey.delete();
+            return keyPair;
+        });
+    };
+
+    proto['EvalMultKeyGenAsync'] = function (privateKey, options) {
+        if (!useWorker) return runChunked([{size: 1, run: () => this.EvalMultKeyGen(privateKey)}], options);
+        const secretKey = Module['SerializePrivateKeyToBuffer'](privateKey, BINARY());
+        return runInWorker({job: 'EvalMultKeyGen', context: contextBytes(this), secretKey}, options)
+            .then(reply => this.DeserializeEvalMultKeyForTagFromBuffer(reply.keys, privateKey.GetKeyTag(), BINARY()));
+    };
+
+    proto['EvalSumKeyGenAsync'] = function (privateKey, options) {
+        if (!useWorker) return runChunked([{size: 1, run: () => this.EvalSumKeyGen(privateKey)}], options);
+        const secretKey = Module['SerializePrivateKeyToBuffer'](privateKey, BINARY());
+        // EvalSum keys are kept with the rotation keys of the tag
+        return runInWorker({job: 'EvalSumKeyGen', context: contextBytes(this), secretKey}, options)
+            .then(reply => this.DeserializeEvalAutomorphismKeyForTagFromBuffer(
+                reply.keys, privateKey.GetKeyTag(), undefined, BINARY()));
+    };
+
+    proto['EvalAtIndexKeyGenAsync'] = function (privateKey, indexList, options) {
+        const chunkSize = (options && options.chunkSize) || 4;
+        const indices = Array.from(indexList);
+        const chunks = [];
+        for (let i = 0; i < indices.length; i += chunkSize) {
+            const slice = indices.slice(i, i + chunkSize);
+            chunks.push({size: slice.length, run: () => this.EvalAtIndexKeyGen(privateKey, slice)});
+        }
+        return runChunked(chunks, options);
+    };
+});
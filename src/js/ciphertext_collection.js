@@ -0,0 +1,223 @@
+// Random-access ciphertext collections. A collection file holds the
+// ciphertexts of a table and an index of their offsets, so a reader only
+// reads and deserializes the ciphertexts a query touches:
+//
+//   char[8]   magic "OFHECTBL"
+//   uint32    format version
+//   uint32    encoding: 0 = SerializeCiphertextToBuffer (BINARY),
+//                       1 = SerializeCiphertextToRawBuffer (same context)
+//   char[16]  GetContextId() of the context the ciphertexts belong to
+//   payloads
+//   index:    per ciphertext, uint64 offset and uint32 length
+//   trailer:  uint64 index offset, uint32 count, magic "OFHECTBL"
+//
+// All integers are little-endian. The index is written last, so a writer
+// can stream ciphertexts out as they are produced.
+addOnPostRun(() => {
+    const MAGIC = 'OFHECTBL';
+    const VERSION = 1;
+    const HEADER_BYTES = 32;
+    const INDEX_ENTRY_BYTES = 12;
+    const TRAILER_BYTES = 20;
+    const ENCODINGS = ['binary', 'raw'];
+
+    const writeMagic = (bytes, offset) => {
+        for (let i = 0; i < MAGIC.length; i++) bytes[offset + i] = MAGIC.charCodeAt(i);
+    };
+    const hasMagic = (bytes, offset) => {
+        for (let i = 0; i < MAGIC.length; i++) {
+            if (bytes[offset + i] !== MAGIC.charCodeAt(i)) return false;
+        }
+        return true;
+    };
+
+    // Byte source of a reader: a file read at offsets in nodejs, or bytes
+    // already in memory (e.g. a fetched ArrayBuffer).
+    function openSource(source) {
+        if (typeof source === 'string') {
+            const fs = require('fs');
+            const fd = fs.openSync(source, 'r');
+            return {
+                size: fs.fstatSync(fd).size,
+                read(position, length) {
+                    const bytes = new Uint8Array(length);
+                    for (let done = 0; done < length;) {
+                        const n = fs.readSync(fd, bytes, done, length - done, position + done);
+                        if (n === 0) throw new Error('unexpected end of file');
+                        done += n;
+                    }
+                    return bytes;
+                },
+                close: () => fs.closeSync(fd),
+            };
+        }
+        const bytes = ArrayBuffer.isView(source) ?
+            new Uint8Array(source.buffer, source.byteOffset, source.byteLength) : new Uint8Array(source);
+        return {
+            size: bytes.length,
+            read(position, length) {
+                if (position + length > bytes.length) throw new Error('unexpected end of buffer');
+                return bytes.subarray(position, position + length);
+            },
+            close() {
+            },
+        };
+    }
+
+    // Writes a collection to `path` (nodejs), or to memory when `path` is
+    // undefined; close() then returns the bytes.
+    //   encoding - 'binary' (default) or 'raw', see SerializeCiphertextToRawBuffer.
+    class CiphertextCollectionWriter {
+        constructor(cc, path, options) {
+            const encoding = (options && options.encoding) || 'binary';
+            this.cc = cc;
+            this.encoding = ENCODINGS.indexOf(encoding);
+            if (this.encoding < 0) throw new Error('unknown encoding ' + encoding);
+            this.index = [];
+            if (path !== undefined) {
+                const fs = require('fs');
+                const fd = fs.openSync(path, 'w');
+                this.sink = {write: bytes => fs.writeSync(fd, bytes), close: () => fs.closeSync(fd)};
+            } else {
+                const chunks = [];
+                this.sink = {write: bytes => chunks.push(bytes), close: () => chunks};
+            }
+
+            const header = new Uint8Array(HEADER_BYTES);
+            const view = new DataView(header.buffer);
+            writeMagic(header, 0);
+            view.setUint32(8, VERSION, true);
+            view.setUint32(12, this.encoding, true);
+            const contextId = Module['GetContextId'](cc);
+            for (let i = 0; i < 16; i++) header[16 + i] = contextId.charCodeAt(i);
+            this.sink.write(header);
+            this.position = HEADER_BYTES;
+        }
+
+        get length() {
+            return this.index.length;
+        }
+
+        // Appends a ciphertext, or a payload already serialized with the
+        // collection's encoding, and returns its position in the collection.
+        append(ciphertext) {
+            const payload = ArrayBuffer.isView(ciphertext) ? ciphertext : this.encoding === 1 ?
+                Module['SerializeCiphertextToRawBuffer'](this.cc, ciphertext) :
+                Module['SerializeCiphertextToBuffer'](ciphertext, Module['SerType']['BINARY']);
+            this.sink.write(payload);
+            this.index.push([this.position, payload.length]);
+            this.position += payload.length;
+            return this.index.length - 1;
+        }
+
+        close() {
+            const tail = new Uint8Array(this.index.length * INDEX_ENTRY_BYTES + TRAILER_BYTES);
+            const view = new DataView(tail.buffer);
+            this.index.forEach(([offset, length], i) => {
+                view.setBigUint64(i * INDEX_ENTRY_BYTES, BigInt(offset), true);
+                view.setUint32(i * INDEX_ENTRY_BYTES + 8, length, true);
+            });
+            const trailer = this.index.length * INDEX_ENTRY_BYTES;
+            view.setBigUint64(trailer, BigInt(this.position), true);
+            view.setUint32(trailer + 8, this.index.length, true);
+            writeMagic(tail, trailer + 12);
+            this.sink.write(tail);
+
+            const chunks = this.sink.close();
+            if (!chunks) return undefined;
+            const bytes = new Uint8Array(chunks.reduce((sum, chunk) => sum + chunk.length, 0));
+            let offset = 0;
+            chunks.forEach(chunk => {
+                bytes.set(chunk, offset);
+                offset += chunk.length;
+            });
+            return bytes;
+        }
+    }
+
+    // Opens a collection from a file path (nodejs) or from bytes in memory.
+    // Only the header and the index are read up front; get(i) reads and
+    // deserializes one ciphertext, and keeps the last `cacheSize` (default
+    // 64) decoded ciphertexts. get() returns a deep copy the caller owns and
+    // deletes, so evaluating on it in place leaves the cached one intact.
+    class CiphertextCollectionReader {
+        constructor(cc, source, options) {
+            this.cc = cc;
+            this.cacheSize = options && options.cacheSize !== undefined ? options.cacheSize : 64;
+            this.cache = new Map();
+            this.stats = {hits: 0, misses: 0, bytesRead: 0};
+            this.source = openSource(source);
+            try {
+                this.readIndex();
+            } catch (error) {
+                this.source.close();
+                throw error;
+            }
+        }
+
+        readIndex() {
+            const {size} = this.source;
+            if (size < HEADER_BYTES + TRAILER_BYTES) throw new Error('not a ciphertext collection');
+            const header = this.source.read(0, HEADER_BYTES);
+            const trailer = this.source.read(size - TRAILER_BYTES, TRAILER_BYTES);
+            if (!hasMagic(header, 0) || !hasMagic(trailer, 12)) throw new Error('not a ciphertext collection');
+            const headerView = new DataView(header.buffer, header.byteOffset, HEADER_BYTES);
+            if (headerView.getUint32(8, true) !== VERSION) throw new Error('unsupported collection version');
+            this.encoding = headerView.getUint32(12, true);
+            if (this.encoding >= ENCODINGS.length) throw new Error('unknown collection encoding');
+            const contextId = String.fromCharCode(...header.subarray(16, 32));
+            if (contextId !== Module['GetContextId'](this.cc)) {
+                throw new Error('collection was written with a different context (' + contextId + ')');
+            }
+
+            const trailerView = new DataView(trailer.buffer, trailer.byteOffset, TRAILER_BYTES);
+            const indexOffset = Number(trailerView.getBigUint64(0, true));
+            this.length = trailerView.getUint32(8, true);
+            if (indexOffset + this.length * INDEX_ENTRY_BYTES + TRAILER_BYTES !== size) {
+                throw new Error('corrupt collection index');
+            }
+            const index = this.source.read(indexOffset, this.length * INDEX_ENTRY_BYTES);
+            this.index = new DataView(index.buffer, index.byteOffset, index.byteLength);
+        }
+
+        // Serialized payload of ciphertext i, without deserializing it.
+        getBuffer(i) {
+            if (!Number.isInteger(i) || i < 0 || i >= this.length) throw new RangeError('no ciphertext ' + i);
+            const offset = Number(this.index.getBigUint64(i * INDEX_ENTRY_BYTES, true));
+            const length = this.index.getUint32(i * INDEX_ENTRY_BYTES + 8, true);
+            this.stats.bytesRead += length;
+            return this.source.read(offset, length);
+        }
+
+        get(i) {
+            let ciphertext = this.cache.get(i);
+            if (ciphertext !== undefined) {
+                this.stats.hits++;
+                this.cache.delete(i);
+            } else {
+                this.stats.misses++;
+                const payload = this.getBuffer(i);
+                ciphertext = this.encoding === 1 ?
+                    Module['DeserializeCiphertextFromRawBuffer'](this.cc, payload) :
+                    Module['DeserializeCiphertextFromBuffer'](payload, Module['SerType']['BINARY']);
+                if (this.cacheSize === 0) return ciphertext;
+            }
+            this.cache.set(i, ciphertext);
+            if (this.cache.size > this.cacheSize) {
+                const [oldest, evicted] = this.cache.entries().next().value;
+                this.cache.delete(oldest);
+                evicted.delete();
+            }
+            return ciphertext.Clone();
+        }
+
+        close() {
+            this.cache.forEach(ciphertext => ciphertext.delete());
+            this.cache.clear();
+            this.source.close();
+        }
+    }
+
+    Module['CiphertextCollectionWriter'] = CiphertextCollectionWriter;
+    Module['CiphertextCollectionReader'] = CiphertextCollectionReader;
+});
@@ -0,0 +1,66 @@
+// Streaming column encryption (see src/pke/column_encryptor_em.h). `source`
+// is an iterable or async iterable of chunks (Float64Array, Int32Array or
+// arrays of Numbers), e.g. a column read from a file batch by batch; the
+// framed records go to `writable`, a Node stream.Writable (or anything with
+// write()), or in nodejs a file path. Writes are only awaited under
+// backpressure, so the I/O of one chunk overlaps the encryption of the next
+// and at most the writable's highWaterMark plus one chunk is buffered.
+//   onProgress(rows, rowsPerSecond) - called after each chunk.
+//   signal                          - an AbortSignal, checked between chunks.
+// Resolves to {rows, bytes, seconds, rowsPerSecond}.
+addOnPostRun(() => {
+    const waitFor = (emitter, event) => new Promise((resolve, reject) => {
+        const onEvent = () => {
+            emitter.removeListener('error', onError);
+            resolve();
+        };
+        const onError = error => {
+            emitter.removeListener(event, onEvent);
+            reject(error);
+        };
+        emitter.once(event, onEvent);
+        emitter.once('error', onError);
+    });
+
+    Module['EncryptColumnToStream'] = async function (cc, publicKey, source, writable, options) {
+        const {onProgress, signal} = options || {};
+        const ownsWritable = typeof writable === 'string';
+        if (ownsWritable) writable = require('fs').createWriteStream(writable);
+
+        let bytes = 0;
+        const write = async records => {
+            if (records.length === 0) return;
+            bytes += records.length;
+            if (writable.write(records) === false && typeof writable.once === 'function') {
+                await waitFor(writable, 'drain');
+            }
+        };
+
+        const encryptor = new Module['ColumnEncryptor'](cc, publicKey);
+        const start = performance.now();
+        const rowsPerSecond = () => encryptor.GetRowsProcessed() / ((performance.now() - start) / 1000);
+        try {
+            for await (const chunk of source) {
+                throwIfAborted(signal);
+                await write(encryptor.Push(chunk));
+                if (onProgress) onProgress(encryptor.GetRowsProcessed(), rowsPerSecond());
+                await yieldToEventLoop();
+            }
+            await write(encryptor.Finish());
+            if (ownsWritable) {
+                const finished = waitFor(writable, 'finish');
+                writable.end();
+                await finished;
+            }
+            return {
+                rows: encryptor.GetRowsProcessed(),
+                bytes: bytes,
+                seconds: (performance.now() - start) / 1000,
+                rowsPerSecond: rowsPerSecond(),
+            };
+        } finally {
+            if (ownsWritable && !writable.writableFinished) writable.destroy();
+            encryptor.delete();
+        }
+    };
+});
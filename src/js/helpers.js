@@ -0,0 +1,12 @@
+// Helpers shared by the post-js files of openfhe_pke. Every post-js file is
+// appended to the generated module in the order of PKE_POST_JS in
+// src/pke/CMakeLists.txt, inside one scope, so this file comes first.
+
+const yieldToEventLoop = () => new Promise(resolve =>
+    typeof setImmediate === 'function' ? setImmediate(resolve) : setTimeout(resolve, 0));
+
+function throwIfAborted(signal) {
+    if (signal && signal.aborted) {
+        throw signal.reason !== undefined ? signal.reason : new Error('Aborted');
+    }
+}
@@ -0,0 +1,44 @@
+// Reloading of evaluation keys evicted under the memory budget (see
+// src/pke/key_budget_em.h). The reloader is called with the key tag and
+// returns, or resolves to, the tag's serialized keys:
+//   {evalMultKey, evalAutomorphismKey, serType}
+// where either buffer may be omitted.
+addOnPostRun(() => {
+    const proto = Module['CryptoContext_DCRTPoly'].prototype;
+    let reloader = null;
+
+    Module['SetEvalKeyReloader'] = function (fn) {
+        reloader = fn;
+    };
+
+    // only the tag's keys are inserted, even from buffers holding other tenants' keys
+    const loadKeys = (cc, keyTag, keys) => {
+        const serType = keys.serType !== undefined ? keys.serType : Module['SerType']['BINARY'];
+        if (keys.evalMultKey) cc.DeserializeEvalMultKeyForTagFromBuffer(keys.evalMultKey, keyTag, serType);
+        if (keys.evalAutomorphismKey) {
+            cc.DeserializeEvalAutomorphismKeyForTagFromBuffer(keys.evalAutomorphismKey, keyTag, undefined, serType);
+        }
+    };
+
+    // Makes the keys of a tag resident, reloading them if they were evicted,
+    // and marks them most recently used.
+    proto['EnsureEvalKeys'] = function (keyTag) {
+        if (Module['IsEvalKeyEvicted'](keyTag)) {
+            if (!reloader) throw new Error('eval keys of ' + keyTag + ' were evicted and no reloader is set');
+            const keys = reloader(keyTag);
+            if (keys && typeof keys.then === 'function') {
+                throw new Error('the reloader is async, use EnsureEvalKeysAsync');
+            }
+            loadKeys(this, keyTag, keys);
+        }
+        return Module['TouchEvalKeys'](this, keyTag);
+    };
+
+    proto['EnsureEvalKeysAsync'] = async function (keyTag) {
+        if (Module['IsEvalKeyEvicted'](keyTag)) {
+            if (!reloader) throw new Error('eval keys of ' + keyTag + ' were evicted and no reloader is set');
+            loadKeys(this, keyTag, await reloader(keyTag));
+        }
+        return Module['TouchEvalKeys'](this, keyTag);
+    };
+});
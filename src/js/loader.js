@@ -0,0 +1,142 @@
+// Startup helpers for services that create many module instances, installed
+// as lib/openfhe_loader.js next to the module it loads.
+//
+// Every call of the generated factory() reads and compiles the .wasm file
+// again. instantiate() compiles it once per process and instantiates the
+// compiled WebAssembly.Module for each call; the compiled module can also be
+// posted to worker_threads, which then instantiate it without compiling.
+// InstancePool keeps instances ready, so a request only pays for a checkout.
+//
+// V8 does not expose its compiled wasm code to Node, so the compiled module
+// itself cannot be kept on disk across restarts (browsers do this on their
+// own for WebAssembly.compileStreaming). With a cacheDir, Node >= 22.1 caches
+// the compiled JS glue code there; the wasm is compiled once per process.
+//
+// The native addon (src/napi) is loaded with name 'openfhe_pke_native'. It is
+// one instance per process: instantiate() returns it, and InstancePool refuses
+// it, since resetting it on release would clear the state of every caller.
+
+const fs = require('fs');
+const path = require('path');
+
+const compiled = new Map();  // .wasm path -> Promise<WebAssembly.Module>
+
+/**
+ * Caches compiled JS in cacheDir where Node supports it (>= 22.1).
+ * Call it before the first instantiate().
+ * @return true if the cache is enabled.
+ */
+function enableDiskCache(cacheDir) {
+    const nodeModule = require('module');
+    if (typeof nodeModule.enableCompileCache !== 'function') return false;
+    const {status} = nodeModule.enableCompileCache(cacheDir);
+    return status !== nodeModule.constants.compileCacheStatus.FAILED &&
+        status !== nodeModule.constants.compileCacheStatus.DISABLED;
+}
+
+/**
+ * The compiled module of lib/<name>.wasm, compiled on first use.
+ * @return Promise of a WebAssembly.Module.
+ */
+function compileModule(name = 'openfhe_pke') {
+    const wasmPath = path.join(__dirname, name + '.wasm');
+    if (!compiled.has(wasmPath)) {
+        compiled.set(wasmPath, fs.promises.readFile(wasmPath).then(bytes => WebAssembly.compile(bytes)));
+    }
+    return compiled.get(wasmPath);
+}
+
+/**
+ * A new module instance, resolving like `await factory()`.
+ * @param options.name - module to load, 'openfhe_pke' (default), 'openfhe_pke_native' or 'openfhe_binfhe'.
+ * @param options.wasmModule - compiled module to use, e.g. one posted by the main thread.
+ */
+async function instantiate(options = {}) {
+    const name = options.name || 'openfhe_pke';
+    const factory = require(path.join(__dirname, name + '.js'));
+    if (factory.native) return factory();
+
+    const wasmModule = options.wasmModule || await compileModule(name);
+    // the factory's own promise never settles when instantiateWasm fails
+    // asynchronously, so the failure rejects the returned promise directly
+    return new Promise((resolve, reject) => {
+        factory({
+            instantiateWasm: (imports, receiveInstance) => {
+                WebAssembly.instantiate(wasmModule, imports)
+                    .then(instance => receiveInstance(instance, wasmModule))
+                    .catch(reject);
+                return {};  // instantiated asynchronously
+            },
+        }).then(resolve, reject);
+    });
+}
+
+// Global state of openfhe_pke, cleared in this order. openfhe_binfhe binds
+// none of these: its contexts and keys live in the JS handles.
+const resetFunctions = ['StopTracing', 'ClearTrace', 'ClearRotationPlans', 'ClearCryptoContextCache',
+    'ClearKeyBudget', 'ClearAllEvalKeys', 'ReleaseAllContexts'];
+
+/**
+ * Drops the contexts, keys and caches of an instance so it can serve another
+ * request. The heap keeps its size; WebAssembly memory does not shrink.
+ */
+function resetInstance(instance) {
+    for (const name of resetFunctions) {
+        if (typeof instance[name] === 'function') instance[name]();
+    }
+}
+
+class InstancePool {
+    /**
+     * @param size - instances created up front.
+     * @param options - passed to instantiate(); the native module cannot be pooled.
+     */
+    constructor(size, options = {}) {
+        const factory = require(path.join(__dirname, (options.name || 'openfhe_pke') + '.js'));
+        if (factory.native) {
+            throw new TypeError('the native module is a single process-wide instance and cannot be pooled');
+        }
+        this.idle = [];
+        this.waiting = [];
+        this.ready = Promise.all(Array.from({length: size}, () => instantiate(options)))
+            .then(instances => {
+                this.idle.push(...instances);
+            });
+    }
+
+    /**
+     * Checks out an instance, waiting for one to be released if all are in use.
+     */
+    async acquire() {
+        await this.ready;
+        if (this.idle.length) return this.idle.pop();
+        return new Promise(resolve => this.waiting.push(resolve));
+    }
+
+    /**
+     * Resets an instance and returns it to the pool.
+     */
+    release(instance) {
+        resetInstance(instance);
+        const next = this.waiting.shift();
+        if (next) {
+            next(instance);
+        } else {
+            this.idle.push(instance);
+        }
+    }
+
+    /**
+     * Runs fn(instance) on a checked out instance and releases it afterwards.
+     */
+    async run(fn) {
+        const instance = await this.acquire();
+        try {
+            return await fn(instance);
+        } finally {
+            this.release(instance);
+        }
+    }
+}
+
+module.exports = {enableDiskCache, compileModule, instantiate, resetInstance, InstancePool};
@@ -0,0 +1,216 @@
+// Parameter auto-tuning. TuneParameters(workload, options) generates a
+// context for every candidate parameter set, times the workload's operations
+// on it in-process and resolves to the fastest candidate that meets the
+// workload's precision (CKKS) or correctness (BFV, BGV) constraint:
+//   {params, settings, msPerWorkload, results}
+// where params is a CCParams object ready for GenCryptoContext*, settings
+// the plain description of the winning candidate and results the
+// measurements of every candidate. The workload is
+//   scheme              - 'CKKS' (default), 'BFV' or 'BGV'
+//   securityLevel       - a SecurityLevel (default HEStd_128_classic)
+//   multiplicativeDepth - default 1
+//   rotations           - rotation indices used by the workload
+//   ops                 - {mult, add, rotate, encrypt, decrypt} counts of a
+//                         workload run (default one mult, one add and, if
+//                         there are rotations, one rotate)
+//   precisionBits       - CKKS precision target after the full depth (default 20)
+//   plaintextModulus    - BFV/BGV (default 65537)
+//   batchSize           - optional
+//   ringDimension       - optional, e.g. with HEStd_NotSet
+// and the options are {repetitions, candidates, onProgress, signal}, where
+// candidates replaces the enumerated settings. Each candidate runs key
+// generation, so tuning takes seconds per candidate; the contexts it creates
+// stay registered with OpenFHE until ReleaseAllContexts().
+addOnPostRun(() => {
+    const enumerate = (lists) => lists.reduce(
+        (settings, list) => settings.flatMap(s => list.map(option => Object.assign({}, s, option))), [{}]);
+
+    function candidateSettings(workload) {
+        const scheme = workload.scheme;
+        const depth = workload.multiplicativeDepth;
+        const ScalingTechnique = Module['ScalingTechnique'];
+        const KeySwitchTechnique = Module['KeySwitchTechnique'];
+
+        const keySwitching = [{keySwitchTechnique: KeySwitchTechnique['BV'], digitSize: 0}];
+        for (let digits = 0; digits <= Math.min(3, depth + 1); digits++) {
+            keySwitching.push({keySwitchTechnique: KeySwitchTechnique['HYBRID'], numLargeDigits: digits});
+        }
+
+        if (scheme === 'CKKS') {
+            const precision = workload.precisionBits;
+            const scalingModSizes = [...new Set([precision + 10, precision + 20, 50])]
+                .filter(bits => bits >= 20 && bits <= 59);
+            return enumerate([
+                scalingModSizes.map(bits => ({scalingModSize: bits, firstModSize: Math.min(60, bits + 10)})),
+                ['FLEXIBLEAUTO', 'FIXEDAUTO'].map(name => ({scalingTechnique: ScalingTechnique[name]})),
+                keySwitching,
+            ]);
+        }
+        if (scheme === 'BFV') {
+            const MultiplicationTechnique = Module['MultiplicationTechnique'];
+            const EncryptionTechnique = Module['EncryptionTechnique'];
+            return enumerate([
+                ['HPS', 'BEHZ', 'HPSPOVERQ', 'HPSPOVERQLEVELED']
+                    .map(name => ({multiplicationTechnique: MultiplicationTechnique[name]})),
+                ['STANDARD', 'EXTENDED'].map(name => ({encryptionTechnique: EncryptionTechnique[name]})),
+                keySwitching,
+            ]);
+        }
+        return enumerate([
+            ['FLEXIBLEAUTO', 'FIXEDAUTO'].map(name => ({scalingTechnique: ScalingTechnique[name]})),
+            keySwitching,
+        ]);
+    }
+
+    function makeParams(workload, settings) {
+        const params = new Module['CCParamsCryptoContext' + workload.scheme + 'RNS']();
+        params.SetSecurityLevel(workload.securityLevel);
+        params.SetMultiplicativeDepth(workload.multiplicativeDepth);
+        if (workload.scheme !== 'CKKS') params.SetPlaintextModulus(workload.plaintextModulus);
+        if (workload.batchSize) params.SetBatchSize(workload.batchSize);
+        if (workload.ringDimension) params.SetRingDim(workload.ringDimension);
+        const setters = {
+            scalingModSize: 'SetScalingModSize',
+            firstModSize: 'SetFirstModSize',
+            scalingTechnique: 'SetScalingTechnique',
+            keySwitchTechnique: 'SetKeySwitchTechnique',
+            digitSize: 'SetDigitSize',
+            numLargeDigits: 'SetNumLargeDigits',
+            multiplicationTechnique: 'SetMultiplicationTechnique',
+            encryptionTechnique: 'SetEncryptionTechnique',
+        };
+        for (const [key, setter] of Object.entries(setters)) {
+            if (settings[key] !== undefined) params[setter](settings[key]);
+        }
+        return params;
+    }
+
+    // average ms of fn over the repetitions; fn returns the handle to delete
+    function time(repetitions, fn) {
+        let total = 0;
+        for (let i = 0; i < repetitions; i++) {
+            const start = performance.now();
+            const result = fn(i);
+            total += performance.now() - start;
+            if (result && result.delete) result.delete();
+        }
+        return total / repetitions;
+    }
+
+    function measure(workload, settings, repetitions) {
+        const isCKKS = workload.scheme === 'CKKS';
+        const params = makeParams(workload, settings);
+        const cc = new Module['GenCryptoContext' + workload.scheme](params);
+        ['PKE', 'KEYSWITCH', 'LEVELEDSHE'].forEach(feature => cc.Enable(Module['PKESchemeFeature'][feature]));
+        const handles = [params];
+        const keyPair = cc.KeyGen();
+        const keyTag = keyPair.secretKey.GetKeyTag();
+        try {
+            cc.EvalMultKeyGen(keyPair.secretKey);
+            if (workload.rotations.length > 0) cc.EvalAtIndexKeyGen(keyPair.secretKey, workload.rotations);
+
+            // powers of values in [-1, 1] stay in range at any depth
+            const slots = Math.min(cc.GetBatchSize() || cc.GetRingDimension(), 64);
+            const values = Array.from({length: slots}, (_, i) => isCKKS ? Math.cos(i) : (i % 3) - 1);
+            let plaintext;
+            if (isCKKS) {
+                const vector = new Module['VectorDouble'](values);
+                plaintext = cc.MakeCKKSPackedPlaintext(vector);
+                vector.delete();
+            } else {
+                plaintext = cc.MakePackedPlaintextInt64(values);
+            }
+            const ciphertext = cc.Encrypt(keyPair.publicKey, plaintext);
+            handles.push(plaintext, ciphertext);
+
+            const ms = {
+                mult: time(repetitions, () => cc.EvalMultCipherCipher(ciphertext, ciphertext)),
+                add: time(repetitions, () => cc.EvalAddCipherCipher(ciphertext, ciphertext)),
+                rotate: workload.rotations.length === 0 ? 0 : time(repetitions,
+                    i => cc.EvalAtIndex(ciphertext, workload.rotations[i % workload.rotations.length])),
+                encrypt: time(repetitions, () => cc.Encrypt(keyPair.publicKey, plaintext)),
+                decrypt: time(repetitions, () => cc.Decrypt(keyPair.secretKey, ciphertext)),
+            };
+            const msPerWorkload = Object.entries(workload.ops).reduce((sum, [op, count]) => sum + count * ms[op], 0);
+
+            // values^(depth + 1) uses the full multiplicative depth
+            let power = ciphertext.clone();
+            for (let d = 0; d < workload.multiplicativeDepth; d++) {
+                const next = cc.EvalMultCipherCipher(power, ciphertext);
+                power.delete();
+                power = next;
+            }
+            const decrypted = cc.Decrypt(keyPair.secretKey, power);
+            handles.push(power, decrypted);
+            decrypted.SetLength(slots);
+            const got = isCKKS ? decrypted.GetRealPackedValue() : decrypted.GetPackedValue();
+            handles.push(got);
+            let maxError = 0;
+            values.forEach((value, i) => {
+                const expected = Math.pow(value, workload.multiplicativeDepth + 1);
+                maxError = Math.max(maxError, Math.abs(Number(got.get(i)) - expected));
+            });
+            const precisionBits = isCKKS ? -Math.log2(Math.max(maxError, Number.EPSILON)) : undefined;
+            const ok = isCKKS ? precisionBits >= workload.precisionBits : maxError === 0;
+
+            return {settings, ringDimension: cc.GetRingDimension(), ms, msPerWorkload, precisionBits, ok};
+        } finally {
+            handles.forEach(handle => handle.delete());
+            Module['ClearEvalKeysForTag'](keyTag);
+            keyPair.delete();
+            cc.delete();
+        }
+    }
+
+    Module['TuneParameters'] = async function (workload, options) {
+        const {repetitions = 3, onProgress, signal} = options || {};
+        workload = Object.assign({
+            scheme: 'CKKS',
+            securityLevel: Module['SecurityLevel']['HEStd_128_classic'],
+            multiplicativeDepth: 1,
+            rotations: [],
+            precisionBits: 20,
+            plaintextModulus: 65537,
+        }, workload);
+        workload.rotations = Array.from(workload.rotations);
+        workload.ops = Object.assign({}, workload.ops ||
+            {mult: 1, add: 1, rotate: workload.rotations.length > 0 ? 1 : 0});
+        if (!['CKKS', 'BFV', 'BGV'].includes(workload.scheme)) throw new Error('unknown scheme ' + workload.scheme);
+        for (const [op, count] of Object.entries(workload.ops)) {
+            if (!['mult', 'add', 'rotate', 'encrypt', 'decrypt'].includes(op)) throw new Error('unknown op ' + op);
+            if (typeof count !== 'number' || !(count >= 0)) {
+                throw new Error(`op count for ${op} must be a non-negative number`);
+            }
+        }
+        if (workload.ops.rotate > 0 && workload.rotations.length === 0) {
+            throw new Error('rotate ops need the workload rotations');
+        }
+
+        const candidates = (options && options.candidates) || candidateSettings(workload);
+        const results = [];
+        for (const settings of candidates) {
+            await yieldToEventLoop();
+            throwIfAborted(signal);
+            let result;
+            try {
+                result = measure(workload, settings, repetitions);
+            } catch (error) {
+                // e.g. a digit count the moduli chain cannot be split into
+                const message = typeof error === 'number' ? Module['getExceptionMessage'](error) : error.message;
+                result = {settings, ok: false, error: String(message)};
+            }
+            results.push(result);
+            if (onProgress) onProgress(results.length, candidates.length, result);
+        }
+
+        const passing = results.filter(result => result.ok);
+        if (passing.length === 0) throw new Error('no candidate parameter set meets the workload constraints');
+        const best = passing.reduce((a, b) => b.msPerWorkload < a.msPerWorkload ? b : a);
+        return {
+            params: makeParams(workload, best.settings),
+            settings: best.settings,
+            msPerWorkload: best.msPerWorkload,
+            results: results,
+        };
+    };
+});
@@ -0,0 +1,91 @@
+// A cache of serialized evaluation keys shared across worker_threads.
+// SharedSerializedKeyCache.create() serializes the relinearization key and
+// every rotation key of a key tag separately into one SharedArrayBuffer; its
+// `descriptor` is posted to the workers, where postMessage shares the buffer
+// instead of copying it. ensure() deserializes the keys a worker's queries
+// ask for, and reloads them from the buffer when the key budget
+// (SetEvalKeyBudget) has evicted them.
+//
+// Only the serialized bytes are shared. Each wasm instance has its own linear
+// memory and key switching reads the keys from it, so every worker still
+// deserializes its own copy of each key it uses: key memory grows with the
+// number of workers. The cache saves the per-worker copies of the serialized
+// keys and the round trips to storage when keys are (re)loaded.
+addOnPostRun(() => {
+    const BINARY = () => Module['SerType']['BINARY'];
+
+    class SharedSerializedKeyCache {
+        // rotations defaults to none; evalMult to true
+        static create(cc, keyTag, options) {
+            const {rotations = [], evalMult = true} = options || {};
+            const blobs = [];
+            if (evalMult) blobs.push(['mult', cc.SerializeEvalMultKeyForTagToBuffer(keyTag, BINARY())]);
+            for (const index of rotations) {
+                blobs.push([index, cc.SerializeEvalAutomorphismKeyForTagToBuffer(keyTag, [index], BINARY())]);
+            }
+
+            const size = blobs.reduce((sum, [, blob]) => sum + blob.length, 0);
+            const Buffer = typeof SharedArrayBuffer === 'function' ? SharedArrayBuffer : ArrayBuffer;
+            const buffer = new Buffer(size);
+            const bytes = new Uint8Array(buffer);
+            const descriptor = {keyTag, buffer, evalMultKey: null, rotations: {}};
+            let offset = 0;
+            for (const [key, blob] of blobs) {
+                bytes.set(blob, offset);
+                if (key === 'mult') {
+                    descriptor.evalMultKey = [offset, blob.length];
+                } else {
+                    descriptor.rotations[key] = [offset, blob.length];
+                }
+                offset += blob.length;
+            }
+            return new SharedSerializedKeyCache(descriptor);
+        }
+
+        constructor(descriptor) {
+            this.descriptor = descriptor;
+            this.keyTag = descriptor.keyTag;
+            this.loaded = new Set();
+        }
+
+        get byteLength() {
+            return this.descriptor.buffer.byteLength;
+        }
+
+        blob([offset, length]) {
+            return new Uint8Array(this.descriptor.buffer, offset, length);
+        }
+
+        // Makes the relinearization key (unless evalMult is false) and the
+        // rotation keys for `rotations` resident in this instance, loading
+        // only those it does not hold yet.
+        ensure(cc, rotations, options) {
+            const evalMult = !options || options.evalMult !== false;
+            if (Module['IsEvalKeyEvicted'](this.keyTag)) this.loaded.clear();
+
+            if (evalMult && !this.loaded.has('mult')) {
+                if (!this.descriptor.evalMultKey) throw new Error('the cache has no EvalMult key');
+                const blob = this.blob(this.descriptor.evalMultKey);
+                cc.DeserializeEvalMultKeyForTagFromBuffer(blob, this.keyTag, BINARY());
+                this.loaded.add('mult');
+            }
+            for (const index of rotations || []) {
+                if (this.loaded.has(index)) continue;
+                const entry = this.descriptor.rotations[index];
+                if (!entry) throw new Error('the cache has no rotation key for index ' + index);
+                cc.DeserializeEvalAutomorphismKeyForTagFromBuffer(this.blob(entry), this.keyTag, [index], BINARY());
+                this.loaded.add(index);
+            }
+            return Module['TouchEvalKeys'](cc, this.keyTag);
+        }
+
+        // Drops this instance's copies of the keys; the shared buffer stays.
+        release() {
+            Module['ClearEvalKeysForTag'](this.keyTag);
+            Module['UntrackEvalKeys'](this.keyTag);
+            this.loaded.clear();
+        }
+    }
+
+    Module['SharedSerializedKeyCache'] = SharedSerializedKeyCache;
+});
@@ -0,0 +1,12 @@
+
+// Chrome trace_event export of the spans recorded between StartTracing() and
+// StopTracing() (see src/core/trace_em.h). In nodejs the event times are
+// mapped onto process.hrtime(), the clock --cpu-prof profiles use, and the
+// events carry process.pid, so both line up on one timeline.
+addOnPostRun(() => {
+    Module['ExportTrace'] = function () {
+        const inNode = typeof process === 'object' && process.hrtime && process.hrtime.bigint;
+        const offsetUs = inNode ? Number(process.hrtime.bigint() / 1000n) - Module['GetTraceClock']() * 1000 : 0;
+        return JSON.parse(Module['ExportTraceJSON'](offsetUs, inNode ? process.pid : 1));
+    };
+});
@@ -0,0 +1,11 @@
+// Entry point of the native Node addon. The bindings themselves come from
+// CryptoContext_em.cpp, compiled against the embind stand-ins in this
+// directory.
+#include <emscripten/bind.h>
+
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+  emscripten::internal::InitializeBindings(env, exports);
+  return exports;
+}
+
+NODE_API_MODULE(openfhe_pke_native, Init)
@@ -0,0 +1,32 @@
+#ifndef _OPENFHEWEB_NAPI_EMSCRIPTEN_H
+#define _OPENFHEWEB_NAPI_EMSCRIPTEN_H
+
+// Stand-in for <emscripten.h> in the native addon.
+
+#include <chrono>
+
+#include "emscripten/val.h"
+
+/**
+ * @brief Call func(arg) from the event loop after millis milliseconds.
+ */
+inline void emscripten_async_call(void (*func)(void *), void *arg, int millis) {
+  auto env = emscripten::internal::Env();
+  auto callback = Napi::Function::New(env, [func, arg](const Napi::CallbackInfo &info) {
+    return emscripten::internal::Guarded(info.Env(), [&]() {
+      func(arg);
+      return info.Env().Undefined();
+    });
+  });
+  env.Global().Get("setTimeout").As<Napi::Function>().Call({callback, Napi::Number::New(env, millis)});
+}
+
+/**
+ * @brief Milliseconds of a monotonic clock, like performance.now() in WASM.
+ */
+inline double emscripten_get_now() {
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration<double, std::milli>(now).count();
+}
+
+#endif
@@ -0,0 +1,395 @@
+#ifndef _OPENFHEWEB_NAPI_EMSCRIPTEN_BIND_H
+#define _OPENFHEWEB_NAPI_EMSCRIPTEN_BIND_H
+
+// The subset of embind used by the bindings, implemented with N-API.
+//
+// Registration runs when the addon is loaded: every EMSCRIPTEN_BINDINGS block
+// adds its classes, functions and enums to the exports object. Overloads are
+// told apart by the number of JS arguments, as in embind.
+
+#include "emscripten/val.h"
+
+#include <tuple>
+
+namespace emscripten {
+
+struct allow_raw_pointers {};
+
+template<typename BaseClass>
+struct base {
+  using type = BaseClass;
+};
+
+template<typename Signature>
+Signature *select_overload(Signature *fn) {
+  return fn;
+}
+
+template<typename Signature, typename ClassType>
+auto select_overload(Signature ClassType::*fn) -> decltype(fn) {
+  return fn;
+}
+
+namespace internal {
+
+using Invoker = std::function<Napi::Value(const Napi::CallbackInfo &)>;
+
+struct Overloads {
+  std::string name;
+  std::map<size_t, Invoker> byArity;
+};
+
+inline Napi::Value CallOverload(const Napi::CallbackInfo &info) {
+  auto env = info.Env();
+  auto *overloads = static_cast<Overloads *>(info.Data());
+  if (overloads->byArity.empty()) {
+    throw Napi::TypeError::New(env, overloads->name + " has no accessible constructor");
+  }
+  const auto it = overloads->byArity.find(info.Length());
+  if (it == overloads->byArity.end()) {
+    throw Napi::TypeError::New(env, "function " + overloads->name + " called with " +
+        std::to_string(info.Length()) + " arguments");
+  }
+  return Guarded(env, [&]() { return it->second(info); });
+}
+
+inline Napi::Value ConstructorCallback(const Napi::CallbackInfo &info) {
+  if (info.Length() == 1 && info[0].IsExternal() && info[0].As<Napi::External<void>>().Data() == HandleToken()) {
+    return info.This();
+  }
+  return CallOverload(info);
+}
+
+using OverloadTable = std::map<std::string, Overloads *>;
+
+inline OverloadTable &FunctionTable() {
+  static OverloadTable table;
+  return table;
+}
+
+inline std::unordered_map<std::type_index, OverloadTable> &MethodTables() {
+  static std::unordered_map<std::type_index, OverloadTable> tables;
+  return tables;
+}
+
+inline void AddOverload(Napi::Object target, OverloadTable &table, const std::string &name, size_t arity,
+                        Invoker invoker) {
+  auto &overloads = table[name];
+  if (overloads == nullptr) {
+    overloads = new Overloads{name, {}};
+    target.Set(name, Napi::Function::New(Env(), CallOverload, name, overloads));
+  }
+  overloads->byArity[arity] = std::move(invoker);
+}
+
+inline void SetPrototypeOf(Napi::Object object, Napi::Value prototype) {
+  auto env = Env();
+  env.Global().Get("Object").As<Napi::Object>().Get("setPrototypeOf").As<Napi::Function>().Call(
+      {object, prototype});
+}
+
+/**
+ * @brief JS argument I of a call; for methods bound as free functions the
+ * first C++ parameter is the object the method is called on.
+ */
+template<bool Method>
+Napi::Value Argument(const Napi::CallbackInfo &info, size_t i) {
+  if constexpr (Method) {
+    return i == 0 ? info.This() : info[i - 1];
+  } else {
+    return info[i];
+  }
+}
+
+template<bool Method, typename R, typename... Args, size_t... I>
+Napi::Value InvokeFunction(R (*fn)(Args...), const Napi::CallbackInfo &info, std::index_sequence<I...>) {
+  std::tuple<typename Binding<Args>::Holder...> holders{Binding<Args>::FromJS(Argument<Method>(info, I))...};
+  if constexpr (std::is_void<R>::value) {
+    fn(Binding<Args>::Get(std::get<I>(holders))...);
+    return info.Env().Undefined();
+  } else {
+    return ToJS(fn(Binding<Args>::Get(std::get<I>(holders))...));
+  }
+}
+
+template<bool Method, typename R, typename... Args>
+Invoker MakeFunctionInvoker(R (*fn)(Args...)) {
+  return [fn](const Napi::CallbackInfo &info) {
+    return InvokeFunction<Method>(fn, info, std::index_sequence_for<Args...>());
+  };
+}
+
+template<typename T, typename... Args, typename F, size_t... I>
+Napi::Value InvokeMember(F member, const Napi::CallbackInfo &info, std::index_sequence<I...>) {
+  auto self = UnwrapShared<T>(info.This());
+  if (!self) throw std::runtime_error("cannot call a method on a deleted object");
+  std::tuple<typename Binding<Args>::Holder...> holders{Binding<Args>::FromJS(info[I])...};
+  using R = decltype(((*self).*member)(Binding<Args>::Get(std::get<I>(holders))...));
+  if constexpr (std::is_void<R>::value) {
+    ((*self).*member)(Binding<Args>::Get(std::get<I>(holders))...);
+    return info.Env().Undefined();
+  } else {
+    return ToJS(((*self).*member)(Binding<Args>::Get(std::get<I>(holders))...));
+  }
+}
+
+template<typename F>
+struct MemberFunction;
+
+#define OPENFHEWEB_MEMBER_FUNCTION(QUALIFIERS)                                                      \
+  template<typename R, typename C, typename... Args>                                                \
+  struct MemberFunction<R (C::*)(Args...) QUALIFIERS> {                                             \
+    static constexpr size_t arity = sizeof...(Args);                                                \
+    template<typename T>                                                                            \
+    static Invoker MakeInvoker(R (C::*member)(Args...) QUALIFIERS) {                                \
+      return [member](const Napi::CallbackInfo &info) {                                             \
+        return InvokeMember<T, Args...>(member, info, std::index_sequence_for<Args...>());          \
+      };                                                                                            \
+    }                                                                                               \
+  };
+
+OPENFHEWEB_MEMBER_FUNCTION()
+OPENFHEWEB_MEMBER_FUNCTION(const)
+OPENFHEWEB_MEMBER_FUNCTION(noexcept)
+OPENFHEWEB_MEMBER_FUNCTION(const noexcept)
+
+#undef OPENFHEWEB_MEMBER_FUNCTION
+
+template<typename T>
+void VectorPushBack(std::vector<T> &vector, const T &value) { vector.push_back(value); }
+
+template<typename T>
+void VectorResize(std::vector<T> &vector, size_t size, const T &value) { vector.resize(size, value); }
+
+template<typename T>
+size_t VectorSize(const std::vector<T> &vector) { return vector.size(); }
+
+template<typename T>
+val VectorGet(const std::vector<T> &vector, size_t index) {
+  return index < vector.size() ? val(vector[index]) : val::undefined();
+}
+
+template<typename T>
+bool VectorSet(std::vector<T> &vector, size_t index, const T &value) {
+  vector[index] = value;
+  return true;
+}
+
+template<typename K, typename V>
+size_t MapSize(const std::map<K, V> &map) { return map.size(); }
+
+template<typename K, typename V>
+val MapGet(const std::map<K, V> &map, const K &key) {
+  const auto it = map.find(key);
+  return it != map.end() ? val(it->second) : val::undefined();
+}
+
+template<typename K, typename V>
+void MapSet(std::map<K, V> &map, const K &key, const V &value) { map[key] = value; }
+
+template<typename K, typename V>
+val MapKeys(const std::map<K, V> &map) {
+  auto keys = val::array();
+  for (const auto &entry : map) keys.call<void>("push", entry.first);
+  return keys;
+}
+
+inline std::vector<void (*)()> &Initializers() {
+  static std::vector<void (*)()> initializers;
+  return initializers;
+}
+
+struct InitFunc {
+  explicit InitFunc(void (*init)()) { Initializers().push_back(init); }
+};
+
+/**
+ * @brief Run all EMSCRIPTEN_BINDINGS blocks against the exports of the addon.
+ */
+inline void InitializeBindings(Napi::Env env, Napi::Object exports) {
+  CurrentEnv() = env;
+  Exports() = Napi::Persistent(exports);
+  Exports().SuppressDestruct();
+  for (auto init : Initializers()) init();
+}
+
+}  // namespace internal
+
+template<typename T, typename BaseSpecifier = void>
+class class_ {
+ public:
+  explicit class_(const char *name) {
+    auto env = internal::Env();
+    auto *constructors = new internal::Overloads{name, {}};
+    auto constructor = Napi::Function::New(env, internal::ConstructorCallback, name, constructors);
+
+    auto &info = internal::Classes()[typeid(T)];
+    info.name = name;
+    info.constructor = Napi::Persistent(constructor);
+    info.constructor.SuppressDestruct();
+    m_constructors = constructors;
+
+    if constexpr (!std::is_void<BaseSpecifier>::value) {
+      using BaseClass = typename BaseSpecifier::type;
+      info.bases.emplace_back(typeid(BaseClass), [](const std::shared_ptr<void> &ptr) {
+        return std::static_pointer_cast<void>(std::shared_ptr<BaseClass>(std::static_pointer_cast<T>(ptr)));
+      });
+      const auto &baseInfo = internal::GetClassInfo(typeid(BaseClass));
+      internal::SetPrototypeOf(Prototype(), baseInfo.constructor.Value().Get("prototype"));
+      internal::SetPrototypeOf(constructor, baseInfo.constructor.Value());
+    }
+
+    Prototype().Set("delete", Napi::Function::New(env, [](const Napi::CallbackInfo &info) {
+      if (auto *handle = internal::GetHandle(info.This())) handle->ptr.reset();
+    }, "delete"));
+    // like embind's clone(): a second handle sharing the object, deleted independently
+    Prototype().Set("clone", Napi::Function::New(env, [](const Napi::CallbackInfo &info) {
+      return internal::Guarded(info.Env(), [&info]() {
+        auto *handle = internal::GetHandle(info.This());
+        if (handle == nullptr || !handle->ptr) throw std::runtime_error("cannot clone a deleted object");
+        return internal::WrapHandle(handle->type, handle->ptr);
+      });
+    }, "clone"));
+    internal::Exports().Value().Set(name, constructor);
+  }
+
+  template<typename SmartPtr>
+  class_ &smart_ptr(const char *) {
+    return *this;
+  }
+
+  template<typename... Args>
+  class_ &constructor() {
+    return constructor(&Construct<Args...>);
+  }
+
+  template<typename R, typename... Args, typename... Policies>
+  class_ &constructor(R (*factory)(Args...), Policies...) {
+    m_constructors->byArity[sizeof...(Args)] = internal::MakeFunctionInvoker<false>(factory);
+    return *this;
+  }
+
+  /**
+   * @brief Method bound as a free function taking the object first.
+   */
+  template<typename R, typename... Args, typename... Policies>
+  class_ &function(const char *name, R (*fn)(Args...), Policies...) {
+    static_assert(sizeof...(Args) > 0, "a method needs the object as its first parameter");
+    AddMethod(name, sizeof...(Args) - 1, internal::MakeFunctionInvoker<true>(fn));
+    return *this;
+  }
+
+  template<typename F, typename... Policies>
+  std::enable_if_t<std::is_member_function_pointer<F>::value, class_ &>
+  function(const char *name, F member, Policies...) {
+    using Traits = internal::MemberFunction<F>;
+    AddMethod(name, Traits::arity, Traits::template MakeInvoker<T>(member));
+    return *this;
+  }
+
+  template<typename C, typename M>
+  class_ &property(const char *name, M C::*member) {
+    auto env = internal::Env();
+    auto getter = Napi::Function::New(env, [member](const Napi::CallbackInfo &info) {
+      return internal::Guarded(info.Env(), [&]() {
+        return internal::ToJS(Self(info).get()->*member);
+      });
+    }, name);
+    auto setter = Napi::Function::New(env, [member](const Napi::CallbackInfo &info) {
+      return internal::Guarded(info.Env(), [&]() {
+        Self(info).get()->*member = internal::FromJS<M>(info[0]);
+        return info.Env().Undefined();
+      });
+    }, name);
+
+    auto descriptor = Napi::Object::New(env);
+    descriptor.Set("get", getter);
+    descriptor.Set("set", setter);
+    descriptor.Set("enumerable", true);
+    env.Global().Get("Object").As<Napi::Object>().Get("defineProperty").As<Napi::Function>().Call(
+        {Prototype(), Napi::String::New(env, name), descriptor});
+    return *this;
+  }
+
+ private:
+  template<typename... Args>
+  static std::shared_ptr<T> Construct(Args... args) {
+    return std::make_shared<T>(std::move(args)...);
+  }
+
+  static std::shared_ptr<T> Self(const Napi::CallbackInfo &info) {
+    auto self = internal::UnwrapShared<T>(info.This());
+    if (!self) throw std::runtime_error("cannot access a property of a deleted object");
+    return self;
+  }
+
+  Napi::Object Prototype() const {
+    return internal::GetClassInfo(typeid(T)).constructor.Value().Get("prototype").template As<Napi::Object>();
+  }
+
+  void AddMethod(const char *name, size_t arity, internal::Invoker invoker) {
+    internal::AddOverload(Prototype(), internal::MethodTables()[typeid(T)], name, arity, std::move(invoker));
+  }
+
+  internal::Overloads *m_constructors;
+};
+
+template<typename R, typename... Args, typename... Policies>
+void function(const char *name, R (*fn)(Args...), Policies...) {
+  internal::AddOverload(internal::Exports().Value(), internal::FunctionTable(), name, sizeof...(Args),
+                        internal::MakeFunctionInvoker<false>(fn));
+}
+
+template<typename E>
+class enum_ {
+ public:
+  explicit enum_(const char *name) {
+    auto object = Napi::Object::New(internal::Env());
+    auto &info = internal::Enums()[typeid(E)];
+    info.object = Napi::Persistent(object);
+    info.object.SuppressDestruct();
+    internal::Exports().Value().Set(name, object);
+  }
+
+  enum_ &value(const char *name, E value) {
+    auto env = internal::Env();
+    auto &info = internal::Enums()[typeid(E)];
+    auto entry = Napi::Object::New(env);
+    entry.Set("value", Napi::Number::New(env, static_cast<double>(value)));
+    info.object.Value().Set(name, entry);
+    info.names[static_cast<int64_t>(value)] = name;
+    return *this;
+  }
+};
+
+template<typename T>
+class_<std::vector<T>> register_vector(const char *name) {
+  class_<std::vector<T>> vector(name);
+  vector.template constructor<>()
+      .function("push_back", &internal::VectorPushBack<T>)
+      .function("resize", &internal::VectorResize<T>)
+      .function("size", &internal::VectorSize<T>)
+      .function("get", &internal::VectorGet<T>)
+      .function("set", &internal::VectorSet<T>);
+  return vector;
+}
+
+template<typename K, typename V>
+class_<std::map<K, V>> register_map(const char *name) {
+  class_<std::map<K, V>> map(name);
+  map.template constructor<>()
+      .function("size", &internal::MapSize<K, V>)
+      .function("get", &internal::MapGet<K, V>)
+      .function("set", &internal::MapSet<K, V>)
+      .function("keys", &internal::MapKeys<K, V>);
+  return map;
+}
+
+}  // namespace emscripten
+
+#define EMSCRIPTEN_BINDINGS(name)                                                                \
+  static void embind_init_##name();                                                              \
+  static ::emscripten::internal::InitFunc embind_init_func_##name(&embind_init_##name);          \
+  static void embind_init_##name()
+
+#endif
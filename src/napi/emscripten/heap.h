@@ -0,0 +1,17 @@
+#ifndef _OPENFHEWEB_NAPI_EMSCRIPTEN_HEAP_H
+#define _OPENFHEWEB_NAPI_EMSCRIPTEN_HEAP_H
+
+// Stand-in for <emscripten/heap.h> in the native addon.
+
+#include <malloc.h>
+
+/**
+ * @brief Bytes the allocator obtained from the system, the native
+ * counterpart of the size of the WASM linear memory.
+ */
+inline size_t emscripten_get_heap_size() {
+  const auto info = mallinfo2();
+  return static_cast<size_t>(info.arena) + static_cast<size_t>(info.hblkhd);
+}
+
+#endif
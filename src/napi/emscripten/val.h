@@ -0,0 +1,137 @@
+#ifndef _OPENFHEWEB_NAPI_EMSCRIPTEN_VAL_H
+#define _OPENFHEWEB_NAPI_EMSCRIPTEN_VAL_H
+
+#include "emscripten/wire.h"
+
+namespace emscripten {
+
+/**
+ * @brief emscripten::val over a N-API value. Only lives for the duration of
+ * the call it was created in, like the vals the bindings use.
+ */
+class val {
+ public:
+  explicit val(Napi::Value value) : m_value(value) {}
+
+  template<typename T, typename = std::enable_if_t<!std::is_same<std::decay_t<T>, val>::value &&
+                                                   !std::is_base_of<Napi::Value, std::decay_t<T>>::value &&
+                                                   !std::is_convertible<T, const char *>::value>>
+  explicit val(T &&value) : m_value(internal::ToJS(std::forward<T>(value))) {}
+
+  explicit val(const char *value) : m_value(Napi::String::New(internal::Env(), value)) {}
+
+  static val global(const char *name) { return val(internal::Env().Global().Get(name)); }
+  static val array() { return val(Napi::Array::New(internal::Env())); }
+  static val object() { return val(Napi::Object::New(internal::Env())); }
+  static val undefined() { return val(internal::Env().Undefined()); }
+  static val null() { return val(internal::Env().Null()); }
+
+  template<typename... Args>
+  val new_(Args &&... args) const {
+    return val(m_value.As<Napi::Function>().New({ToValue(std::forward<Args>(args))...}));
+  }
+
+  template<typename R, typename... Args>
+  R call(const char *name, Args &&... args) const {
+    auto object = m_value.As<Napi::Object>();
+    auto result = object.Get(name).As<Napi::Function>().Call(object, {ToValue(std::forward<Args>(args))...});
+    if constexpr (std::is_void<R>::value) {
+      return;
+    } else {
+      return val(result).as<R>();
+    }
+  }
+
+  val operator[](const char *key) const { return val(m_value.As<Napi::Object>().Get(key)); }
+  val operator[](const std::string &key) const { return val(m_value.As<Napi::Object>().Get(key)); }
+  template<typename I, typename = std::enable_if_t<std::is_integral<I>::value>>
+  val operator[](I index) const {
+    return val(m_value.As<Napi::Object>().Get(static_cast<uint32_t>(index)));
+  }
+
+  template<typename K, typename V>
+  void set(const K &key, V &&value) {
+    m_value.As<Napi::Object>().Set(ToValue(key), ToValue(std::forward<V>(value)));
+  }
+
+  template<typename T>
+  T as() const {
+    if constexpr (std::is_same<T, val>::value) {
+      return *this;
+    } else {
+      return internal::FromJS<T>(m_value);
+    }
+  }
+
+  val typeOf() const {
+    switch (m_value.Type()) {
+      case napi_undefined: return val("undefined");
+      case napi_boolean: return val("boolean");
+      case napi_number: return val("number");
+      case napi_string: return val("string");
+      case napi_symbol: return val("symbol");
+      case napi_function: return val("function");
+      case napi_bigint: return val("bigint");
+      default: return val("object");
+    }
+  }
+
+  bool isArray() const { return m_value.IsArray(); }
+  bool isNull() const { return m_value.IsNull(); }
+  bool isUndefined() const { return m_value.IsUndefined(); }
+
+  Napi::Value handle() const { return m_value; }
+
+ private:
+  template<typename T>
+  static Napi::Value ToValue(T &&value) {
+    if constexpr (std::is_same<std::decay_t<T>, val>::value) {
+      return value.m_value;
+    } else if constexpr (std::is_convertible<T, const char *>::value) {
+      return Napi::String::New(internal::Env(), value);
+    } else {
+      return internal::ToJS(std::forward<T>(value));
+    }
+  }
+
+  Napi::Value m_value;
+};
+
+namespace internal {
+
+template<>
+struct BindingType<val> {
+  using Holder = val;
+
+  static Holder FromJS(const Napi::Value &value) { return val(value); }
+  static val &Get(Holder &holder) { return holder; }
+  static Napi::Value ToJS(const val &value) { return value.handle(); }
+};
+
+template<typename T>
+std::vector<T> ArrayToVector(const val &array) {
+  const auto object = array.handle().As<Napi::Object>();
+  const auto length = object.Get("length").ToNumber().Uint32Value();
+  std::vector<T> result;
+  result.reserve(length);
+  for (uint32_t i = 0; i < length; i++) {
+    result.push_back(FromJS<T>(object.Get(i)));
+  }
+  return result;
+}
+
+}  // namespace internal
+
+template<typename T>
+std::vector<T> vecFromJSArray(const val &array) {
+  return internal::ArrayToVector<T>(array);
+}
+
+template<typename T>
+std::vector<T> convertJSArrayToNumberVector(const val &array) {
+  return internal::ArrayToVector<T>(array);
+}
+
+}  // namespace emscripten
+
+#endif
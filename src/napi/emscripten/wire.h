@@ -0,0 +1,309 @@
+#ifndef _OPENFHEWEB_NAPI_EMSCRIPTEN_WIRE_H
+#define _OPENFHEWEB_NAPI_EMSCRIPTEN_WIRE_H
+
+// Conversions between N-API values and C++ types for the native addon.
+//
+// The native backend compiles the same EMSCRIPTEN_BINDINGS blocks as the WASM
+// build; these headers stand in for the embind headers and map every binding
+// onto N-API. Objects handed to JS keep embind's semantics: they hold a
+// std::shared_ptr, carry the prototype of their registered class and expose
+// delete().
+
+#include <napi.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace emscripten {
+namespace internal {
+
+/**
+ * @brief Environment of the call being served. Set on every entry from JS.
+ */
+inline napi_env &CurrentEnv() {
+  static thread_local napi_env env = nullptr;
+  return env;
+}
+
+inline Napi::Env Env() { return Napi::Env(CurrentEnv()); }
+
+/**
+ * @brief Object receiving the bindings, i.e. the module seen from JS.
+ */
+inline Napi::ObjectReference &Exports() {
+  static Napi::ObjectReference exports;
+  return exports;
+}
+
+/**
+ * @brief Run a callback from JS, turning C++ exceptions into JS errors.
+ */
+template<typename F>
+Napi::Value Guarded(Napi::Env env, F &&body) {
+  CurrentEnv() = env;
+  try {
+    return body();
+  } catch (const Napi::Error &) {
+    throw;
+  } catch (const std::exception &e) {
+    throw Napi::Error::New(env, e.what());
+  }
+}
+
+using Upcast = std::function<std::shared_ptr<void>(const std::shared_ptr<void> &)>;
+
+struct ClassInfo {
+  std::string name;
+  Napi::FunctionReference constructor;
+  std::vector<std::pair<std::type_index, Upcast>> bases;
+};
+
+inline std::unordered_map<std::type_index, ClassInfo> &Classes() {
+  static std::unordered_map<std::type_index, ClassInfo> classes;
+  return classes;
+}
+
+struct EnumInfo {
+  Napi::ObjectReference object;
+  std::map<int64_t, std::string> names;
+};
+
+inline std::unordered_map<std::type_index, EnumInfo> &Enums() {
+  static std::unordered_map<std::type_index, EnumInfo> enums;
+  return enums;
+}
+
+/**
+ * @brief Native state of a JS handle.
+ */
+struct Handle {
+  std::type_index type;
+  std::shared_ptr<void> ptr;
+};
+
+/**
+ * @brief Passed to a class constructor to create an empty handle instead of
+ * running a registered C++ constructor.
+ */
+inline void *HandleToken() {
+  static int token;
+  return &token;
+}
+
+inline ClassInfo &GetClassInfo(std::type_index type) {
+  auto it = Classes().find(type);
+  if (it == Classes().end()) {
+    throw std::runtime_error(std::string("type is not registered: ") + type.name());
+  }
+  return it->second;
+}
+
+/**
+ * @brief Create a JS object of the registered class `type` holding `ptr`.
+ */
+inline Napi::Value WrapHandle(std::type_index type, std::shared_ptr<void> ptr) {
+  auto env = Env();
+  auto object = GetClassInfo(type).constructor.New({Napi::External<void>::New(env, HandleToken())});
+  auto *handle = new Handle{type, std::move(ptr)};
+  NAPI_THROW_IF_FAILED(env,
+                       napi_wrap(env, object, handle,
+                                 [](napi_env, void *data, void *) { delete static_cast<Handle *>(data); },
+                                 nullptr, nullptr),
+                       Napi::Value());
+  return object;
+}
+
+template<typename T>
+Napi::Value WrapShared(std::shared_ptr<T> ptr) {
+  using U = std::remove_const_t<T>;
+  if (!ptr) return Env().Null();
+  return WrapHandle(typeid(U), std::static_pointer_cast<void>(std::const_pointer_cast<U>(ptr)));
+}
+
+inline Handle *GetHandle(const Napi::Value &value) {
+  void *data = nullptr;
+  if (!value.IsObject() || napi_unwrap(value.Env(), value, &data) != napi_ok || data == nullptr) {
+    return nullptr;
+  }
+  return static_cast<Handle *>(data);
+}
+
+inline std::shared_ptr<void> UpcastTo(std::type_index from, const std::shared_ptr<void> &ptr,
+                                      std::type_index to) {
+  if (from == to) return ptr;
+  auto it = Classes().find(from);
+  if (it == Classes().end()) return nullptr;
+  for (const auto &base : it->second.bases) {
+    if (auto result = UpcastTo(base.first, base.second(ptr), to)) return result;
+  }
+  return nullptr;
+}
+
+template<typename T>
+std::shared_ptr<T> UnwrapShared(const Napi::Value &value) {
+  using U = std::remove_const_t<T>;
+  if (value.IsNull() || value.IsUndefined()) return nullptr;
+
+  auto *handle = GetHandle(value);
+  if (handle == nullptr) {
+    throw std::runtime_error("expected an instance of " + GetClassInfo(typeid(U)).name);
+  }
+  if (!handle->ptr) {
+    throw std::runtime_error("cannot pass deleted object as a pointer of type " + GetClassInfo(typeid(U)).name);
+  }
+  auto ptr = UpcastTo(handle->type, handle->ptr, typeid(U));
+  if (!ptr) {
+    throw std::runtime_error("expected an instance of " + GetClassInfo(typeid(U)).name + ", got " +
+                             GetClassInfo(handle->type).name);
+  }
+  return std::static_pointer_cast<U>(ptr);
+}
+
+/**
+ * @brief Conversion of a C++ type from and to JS.
+ *
+ * Holder is what an argument is converted into; Get() yields the reference the
+ * C++ function is called with. Registered classes are held by shared_ptr so
+ * reference parameters act on the object owned by the JS handle.
+ */
+template<typename T, typename Enable = void>
+struct BindingType {
+  using Holder = std::shared_ptr<T>;
+
+  static Holder FromJS(const Napi::Value &value) {
+    auto ptr = UnwrapShared<T>(value);
+    if (!ptr) throw std::runtime_error("null is not a valid " + GetClassInfo(typeid(T)).name);
+    return ptr;
+  }
+  static T &Get(Holder &holder) { return *holder; }
+  static Napi::Value ToJS(T &&value) { return WrapShared(std::make_shared<T>(std::move(value))); }
+  static Napi::Value ToJS(const T &value) { return WrapShared(std::make_shared<T>(value)); }
+};
+
+template<typename T>
+struct BindingType<T, std::enable_if_t<std::is_arithmetic<T>::value>> {
+  using Holder = T;
+
+  static Holder FromJS(const Napi::Value &value) {
+    if constexpr (std::is_same<T, bool>::value) return value.ToBoolean().Value();
+    if (value.IsBigInt()) {
+      bool lossless;
+      return std::is_signed<T>::value ? static_cast<T>(value.As<Napi::BigInt>().Int64Value(&lossless))
+                                      : static_cast<T>(value.As<Napi::BigInt>().Uint64Value(&lossless));
+    }
+    return static_cast<T>(value.ToNumber().DoubleValue());
+  }
+  static T &Get(Holder &holder) { return holder; }
+  // 64-bit integers come back as BigInt, as in the -sWASM_BIGINT build. size_t is 64 bits here but 32 bits in
+  // wasm, so bindings return sizes as uint32_t or double to get a Number from both.
+  static Napi::Value ToJS(T value) {
+    if constexpr (std::is_same<T, bool>::value) return Napi::Boolean::New(Env(), value);
+    if constexpr (std::is_integral<T>::value && sizeof(T) == 8) {
+      if constexpr (std::is_signed<T>::value) return Napi::BigInt::New(Env(), static_cast<int64_t>(value));
+      else return Napi::BigInt::New(Env(), static_cast<uint64_t>(value));
+    }
+    return Napi::Number::New(Env(), static_cast<double>(value));
+  }
+};
+
+template<typename T>
+struct BindingType<T, std::enable_if_t<std::is_enum<T>::value>> {
+  using Holder = T;
+
+  static Holder FromJS(const Napi::Value &value) {
+    if (value.IsObject()) return static_cast<T>(value.As<Napi::Object>().Get("value").ToNumber().Int64Value());
+    return static_cast<T>(value.ToNumber().Int64Value());
+  }
+  static T &Get(Holder &holder) { return holder; }
+  static Napi::Value ToJS(T value) {
+    const auto it = Enums().find(typeid(T));
+    if (it != Enums().end()) {
+      const auto name = it->second.names.find(static_cast<int64_t>(value));
+      if (name != it->second.names.end()) return it->second.object.Value().Get(name->second);
+    }
+    return Napi::Number::New(Env(), static_cast<double>(value));
+  }
+};
+
+template<>
+struct BindingType<std::string> {
+  using Holder = std::string;
+
+  static Holder FromJS(const Napi::Value &value) { return value.ToString().Utf8Value(); }
+  static std::string &Get(Holder &holder) { return holder; }
+  static Napi::Value ToJS(const std::string &value) { return Napi::String::New(Env(), value); }
+};
+
+template<typename T>
+struct BindingType<std::shared_ptr<T>> {
+  using Holder = std::shared_ptr<T>;
+
+  static Holder FromJS(const Napi::Value &value) { return UnwrapShared<T>(value); }
+  static Holder &Get(Holder &holder) { return holder; }
+  static Napi::Value ToJS(const std::shared_ptr<T> &value) { return WrapShared(value); }
+};
+
+template<typename T>
+using Binding = BindingType<std::remove_cv_t<std::remove_reference_t<T>>>;
+
+/**
+ * @brief Convert a C++ value to JS.
+ */
+template<typename T>
+Napi::Value ToJS(T &&value) {
+  return Binding<T>::ToJS(std::forward<T>(value));
+}
+
+/**
+ * @brief Convert a JS value to a C++ value.
+ */
+template<typename T>
+std::remove_cv_t<std::remove_reference_t<T>> FromJS(const Napi::Value &value) {
+  auto holder = Binding<T>::FromJS(value);
+  return Binding<T>::Get(holder);
+}
+
+}  // namespace internal
+
+template<typename T>
+struct memory_view {
+  size_t size;
+  const T *data;
+};
+
+/**
+ * @brief View on native memory. In the addon the view is an external
+ * ArrayBuffer, so it aliases the C++ memory just like a view on the WASM heap.
+ */
+template<typename T>
+memory_view<T> typed_memory_view(size_t size, const T *data) {
+  return memory_view<T>{size, data};
+}
+
+namespace internal {
+
+template<typename T>
+struct BindingType<memory_view<T>> {
+  // as in embind, a view on char is an Int8Array
+  using Element = std::conditional_t<std::is_same<T, char>::value, int8_t, T>;
+
+  static Napi::Value ToJS(const memory_view<T> &view) {
+    auto env = Env();
+    auto buffer = Napi::ArrayBuffer::New(env, const_cast<T *>(view.data), view.size * sizeof(T));
+    return Napi::TypedArrayOf<Element>::New(env, view.size, buffer, 0);
+  }
+};
+
+}  // namespace internal
+}  // namespace emscripten
+
+#endif
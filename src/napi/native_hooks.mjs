@@ -0,0 +1,12 @@
+// Module resolution hook registered by use_native.mjs: imports of
+// lib/openfhe_pke.js resolve to the native loader lib/openfhe_pke_native.js.
+const wasmUrl = new URL('./openfhe_pke.js', import.meta.url).href;
+const nativeUrl = new URL('./openfhe_pke_native.js', import.meta.url).href;
+
+export async function resolve(specifier, context, nextResolve) {
+    if (context.parentURL && /^\.{0,2}\//.test(specifier)) {
+        const target = new URL(specifier, context.parentURL).href;
+        if (target === wasmUrl || target + '.js' === wasmUrl) return nextResolve(nativeUrl, context);
+    }
+    return nextResolve(specifier, context);
+}
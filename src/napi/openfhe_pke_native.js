@@ -0,0 +1,44 @@
+// Loader of the native Node addon, installed as lib/openfhe_pke_native.js
+// next to the web-assembly lib/openfhe_pke.js.
+//
+// Mirrors the factory exported by the WASM build: `await factory()` resolves
+// to the module object with the same bindings, plus the JS helpers the WASM
+// build appends with --post-js, installed in lib/openfhe_pke_post_js.
+//
+// Unlike the WASM factory, which instantiates a fresh module on every call,
+// the addon is loaded once per process: every `await factory()` resolves to
+// the same module, so contexts, eval keys, the context cache, key budget and
+// rotation plans are shared by all callers. resetInstance() of
+// lib/openfhe_loader.js clears them.
+const fs = require('fs');
+const path = require('path');
+
+// PKE_POST_JS of src/pke/CMakeLists.txt, in the same order
+const postJs = ['helpers.js', 'async_api.js', 'trace_export.js', 'key_reloader.js', 'column_stream.js',
+    'ciphertext_collection.js', 'param_tuner.js', 'serialized_key_cache.js'];
+
+let modulePromise;
+
+function factory() {
+    if (!modulePromise) {
+        modulePromise = new Promise(resolve => {
+            const Module = require('./openfhe_pke_native.node');
+            // lets code holding a module tell that it is not a separate instance
+            Module['native'] = true;
+            const postRun = [];
+            // one scope for all files, as emscripten appends them
+            const dir = path.join(__dirname, 'openfhe_pke_post_js');
+            const source = postJs.map(file => fs.readFileSync(path.join(dir, file), 'utf8'));
+            const addOnPostRun = callback => postRun.push(callback);
+            new Function('Module', 'addOnPostRun', 'require', source.join('\n'))(Module, addOnPostRun, require);
+            postRun.forEach(callback => callback());
+            resolve(Module);
+        });
+    }
+    return modulePromise;
+}
+
+module.exports = factory;
+module.exports.default = factory;
+// one addon instance per process, see src/js/loader.js
+module.exports.native = true;
@@ -0,0 +1,30 @@
+// Runs code written against the web-assembly module on the native addon,
+// installed as lib/use_native.mjs next to both:
+//
+//   node --import ./lib/use_native.mjs app.js
+//   NODE_OPTIONS="--import ./lib/use_native.mjs" npm test
+//
+// Every import or require() of lib/openfhe_pke.js, with or without the .js
+// extension, then loads lib/openfhe_pke_native.js instead, so existing code,
+// unit tests and benchmarks run unmodified. lib/openfhe_pke.js does not need
+// to exist. Needs Node >= 20.6 for module.register().
+import Module from 'node:module';
+import path from 'node:path';
+import {fileURLToPath} from 'node:url';
+
+const wasmPath = fileURLToPath(new URL('./openfhe_pke.js', import.meta.url));
+const nativePath = fileURLToPath(new URL('./openfhe_pke_native.js', import.meta.url));
+
+// require() from CommonJS
+const resolveFilename = Module._resolveFilename;
+Module._resolveFilename = function (request, parent, ...rest) {
+    if (request.startsWith('.') || path.isAbsolute(request)) {
+        const base = parent && parent.filename ? path.dirname(parent.filename) : process.cwd();
+        const target = path.resolve(base, request);
+        if (target === wasmPath || target + '.js' === wasmPath) request = nativePath;
+    }
+    return resolveFilename.call(this, request, parent, ...rest);
+};
+
+// import from ES modules
+Module.register('./native_hooks.mjs', import.meta.url);
@@ -23,8 +23,21 @@ using namespace emscripten;
 #include "core/parameters.h"
 #include "pubkeylp_em.h"
 #include "pke_serial_em.h"
+#include "context_cache_em.h"
+#include "snapshot_em.h"
+#include "rotation_planner_em.h"
+#include "threshold_em.h"
+#include "multiparty_em.h"
+#include "pre_pipeline_em.h"
+#include "byte_encoding_em.h"
+#include "complex_packing_em.h"
+#include "key_budget_em.h"
+#include "raw_ciphertext_em.h"
+#include "column_encryptor_em.h"
 #include "core/backend_em.h"
 #include "core/clear_context.h"
+#include "core/memory_em.h"
+#include "core/trace_em.h"
 
 CryptoContext<DCRTPoly> GenCryptoContextBFV(CCParams<CryptoContextBFVRNS> params) {
   return GenCryptoContext(params);
@@ -89,6 +102,28 @@ Plaintext MakePackedPlaintextZero(
   return cryptoCtx->MakePackedPlaintext(values, 1, 0);
 }
 
+/**
+ * @brief Packed plaintext from full-width integers.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param values - BigInt64Array or array of Numbers, see MakeVectorInt64().
+ * @return plaintext.
+ */
+template<typename Element>
+Plaintext MakePackedPlaintextInt64(const CryptoContext<Element> &cryptoCtx, const emscripten::val &values) {
+  return cryptoCtx->MakePackedPlaintext(MakeVectorInt64(values));
+}
+
+/**
+ * @brief Coefficient packed plaintext from full-width integers.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param values - BigInt64Array or array of Numbers, see MakeVectorInt64().
+ * @return plaintext.
+ */
+template<typename Element>
+Plaintext MakeCoefPackedPlaintextInt64(const CryptoContext<Element> &cryptoCtx, const emscripten::val &values) {
+  return cryptoCtx->MakeCoefPackedPlaintext(MakeVectorInt64(values));
+}
+
 /**
  * @brief Encrypt a plaintext using a given public key.
  * @param cryptoCtx - Reference to CryptoContext from JS.
@@ -221,6 +256,8 @@ Ciphertext<Element> EvalNegate(const CryptoContext<Element> &cryptoCtx, Cipherte
 
 /**
  * @brief Moves i-th slot to slot 0
+ * If a rotation plan is registered for the ciphertext's key tag, rotations
+ * without a key of their own are composed from the plan's generating set.
  * @param cryptoCtx - Reference to CryptoContext from JS.
  * @param ciphertext -  Input ciphertext.
  * @param index - the index. of the slot.
@@ -230,7 +267,7 @@ template<typename Element>
 Ciphertext<Element> EvalAtIndex(const CryptoContext<Element> &cryptoCtx,
                                 Ciphertext<Element> ciphertext,
                                 int32_t index) {
-  return cryptoCtx->EvalAtIndex(ciphertext, index);
+  return EvalAtIndexPlanned(cryptoCtx, ciphertext, index);
 }
 
 /**
@@ -244,6 +281,92 @@ Ciphertext<Element> ModReduce(const CryptoContext<Element> &cryptoCtx, Ciphertex
   return cryptoCtx->ModReduce(ciphertext);
 }
 
+// In-place variants. The Ciphertext handle held by JS shares ownership of the
+// underlying CiphertextImpl, so mutating through the shared pointer updates
+// the JS object without allocating a new ciphertext or a new handle.
+
+/**
+ * @brief Homomorphic addition of ciphertexts, stored in the first operand.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertext1 - the input ciphertext, overwritten with the sum.
+ * @param ciphertext2 - the input ciphertext.
+ */
+template<typename Element>
+void EvalAddInPlace(const CryptoContext<Element> &cryptoCtx,
+                    Ciphertext<Element> ciphertext1,
+                    Ciphertext<Element> ciphertext2) {
+  cryptoCtx->EvalAddInPlace(ciphertext1, ciphertext2);
+}
+
+/**
+ * @brief Homomorphic subtraction of ciphertexts, stored in the first operand.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertext1 - the input ciphertext, overwritten with the difference.
+ * @param ciphertext2 - the input ciphertext.
+ */
+template<typename Element>
+void EvalSubInPlace(const CryptoContext<Element> &cryptoCtx,
+                    Ciphertext<Element> ciphertext1,
+                    Ciphertext<Element> ciphertext2) {
+  cryptoCtx->EvalSubInPlace(ciphertext1, ciphertext2);
+}
+
+/**
+ * @brief Homomorphic negation of a ciphertext in place.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertext - the input ciphertext, overwritten with its negation.
+ */
+template<typename Element>
+void EvalNegateInPlace(const CryptoContext<Element> &cryptoCtx, Ciphertext<Element> ciphertext) {
+  cryptoCtx->EvalNegateInPlace(ciphertext);
+}
+
+/**
+ * @brief Multiplication of a ciphertext by a constant in place (CKKS).
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertext - the input ciphertext, overwritten with the product.
+ * @param constant - Contant multiplier.
+ */
+template<typename Element>
+void EvalMultInPlace(const CryptoContext<Element> &cryptoCtx, Ciphertext<Element> ciphertext, double constant) {
+  cryptoCtx->EvalMultInPlace(ciphertext, constant);
+}
+
+/**
+ * @brief OpenFHE ModReduce applied in place.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertext - Input ciphertext, mod reduced in place.
+ */
+template<typename Element>
+void ModReduceInPlace(const CryptoContext<Element> &cryptoCtx, Ciphertext<Element> ciphertext) {
+  cryptoCtx->ModReduceInPlace(ciphertext);
+}
+
+/**
+ * @brief OpenFHE Rescale (CKKS alias of ModReduce) applied in place.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertext - Input ciphertext, rescaled in place.
+ */
+template<typename Element>
+void RescaleInPlace(const CryptoContext<Element> &cryptoCtx, Ciphertext<Element> ciphertext) {
+  cryptoCtx->RescaleInPlace(ciphertext);
+}
+
+/**
+ * @brief Rotates a ciphertext in place.
+ * OpenFHE has no in-place automorphism, so the rotated result is moved into
+ * the existing CiphertextImpl; the JS handle stays valid and no new handle is
+ * created.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertext - Input ciphertext, overwritten with the rotation.
+ * @param index - the rotation index.
+ */
+template<typename Element>
+void EvalRotateInPlace(const CryptoContext<Element> &cryptoCtx, Ciphertext<Element> ciphertext, int32_t index) {
+  auto rotated = EvalAtIndexPlanned(cryptoCtx, ciphertext, index);
+  *ciphertext = std::move(*rotated);
+}
+
 /**
  * @brief Function for evaluating a sum of all components.
  * @param cryptoCtx - Reference to CryptoContext from JS.
@@ -272,6 +395,77 @@ Ciphertext<Element> EvalInnerProduct(const CryptoContext<Element> &cryptoCtx,
   return cryptoCtx->EvalInnerProduct(ciphertext1, ciphertext2, batchSize);
 }
 
+/**
+ * @brief Homomorphic multiplication without relinearization.
+ * The product has three elements until Relinearize() is called; products of
+ * this kind can be added together and relinearized once.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertext1 - the input ciphertext.
+ * @param ciphertext2 - the input ciphertext.
+ * @return the degree 2 product.
+ */
+template<typename Element>
+Ciphertext<Element> EvalMultNoRelin(const CryptoContext<Element> &cryptoCtx,
+                                    Ciphertext<Element> ciphertext1,
+                                    Ciphertext<Element> ciphertext2) {
+  return cryptoCtx->EvalMultNoRelin(ciphertext1, ciphertext2);
+}
+
+/**
+ * @brief Key switches a degree 2 ciphertext back to two elements.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertext - the input ciphertext.
+ * @return the relinearized ciphertext.
+ */
+template<typename Element>
+Ciphertext<Element> Relinearize(const CryptoContext<Element> &cryptoCtx, Ciphertext<Element> ciphertext) {
+  return cryptoCtx->Relinearize(ciphertext);
+}
+
+/**
+ * @brief Relinearize() applied in place.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertext - the input ciphertext, relinearized in place.
+ */
+template<typename Element>
+void RelinearizeInPlace(const CryptoContext<Element> &cryptoCtx, Ciphertext<Element> ciphertext) {
+  cryptoCtx->RelinearizeInPlace(ciphertext);
+}
+
+/**
+ * @brief Sum of the pairwise products of two ciphertext lists.
+ * The products are accumulated unrelinearized, so the sum costs a single key
+ * switch instead of one per term. Rescaling is likewise paid once: with
+ * FLEXIBLEAUTO/FIXEDAUTO the sum is rescaled by the next operation, with
+ * FIXEDMANUAL call RescaleInPlace() on the result as after EvalMult.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertexts1 - JS array of ciphertexts.
+ * @param ciphertexts2 - JS array of ciphertexts, same length.
+ * @return the relinearized sum of products.
+ */
+template<typename Element>
+Ciphertext<Element> EvalSumOfProducts(const CryptoContext<Element> &cryptoCtx,
+                                      const emscripten::val &ciphertexts1,
+                                      const emscripten::val &ciphertexts2) {
+  const auto lhs = vecFromJSArray<Ciphertext<Element>>(ciphertexts1);
+  const auto rhs = vecFromJSArray<Ciphertext<Element>>(ciphertexts2);
+  if (lhs.empty() || lhs.size() != rhs.size()) {
+    OPENFHE_THROW("EvalSumOfProducts needs two non-empty lists of equal length");
+  }
+
+  Ciphertext<Element> sum;
+  {
+    TraceSpan span("EvalMultNoRelin", "openfhe");
+    sum = cryptoCtx->EvalMultNoRelin(lhs[0], rhs[0]);
+    for (size_t i = 1; i < lhs.size(); i++) {
+      cryptoCtx->EvalAddInPlace(sum, cryptoCtx->EvalMultNoRelin(lhs[i], rhs[i]));
+    }
+  }
+  TraceSpan span("Relinearize", "openfhe");
+  cryptoCtx->RelinearizeInPlace(sum);
+  return sum;
+}
+
 /**
  * @details OpenFHE function for evaluating multiplication on
  * ciphertext followed by relinearization operation (at the end). It computes
@@ -394,31 +588,70 @@ Ciphertext<Element> ReEncrypt2(const CryptoContext<Element> &cryptoCtx,
 // explicit wrapper methods are required to use
 // non-member (static) functions as member functions
 
+template<typename Element>
+EvalKey<Element> GetFirstEvalKey(const std::vector<EvalKey<Element>> &keys) {
+  return keys.empty() ? nullptr : keys[0];
+}
+
+template<typename Element>
+EvalKey<Element> GetFirstEvalKey(const std::shared_ptr<std::map<usint, EvalKey<Element>>> &keys) {
+  return keys == nullptr || keys->empty() ? nullptr : keys->begin()->second;
+}
+
+/**
+ * @brief Key tags of a static OpenFHE key map whose keys belong to a context.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param allKeys - key map, e.g. CryptoContextImpl::GetAllEvalMultKeys().
+ * @return the key tags.
+ */
+template<typename Element, typename KeyMap>
+std::vector<std::string> GetContextKeyTags(const CryptoContext<Element> &cryptoCtx, const KeyMap &allKeys) {
+  std::vector<std::string> keyTags;
+  for (const auto &kv : allKeys) {
+    const auto key = GetFirstEvalKey<Element>(kv.second);
+    if (key != nullptr && key->GetCryptoContext() == cryptoCtx) keyTags.push_back(kv.first);
+  }
+  return keyTags;
+}
+
 /**
- * @brief flush EvalMultKey cache for a given context.
+ * @brief flush the EvalMultKeys of a given context; other contexts' keys
+ * are kept.
  * @param cryptoCtx - Reference to CryptoContext from JS.
  */
 template<typename Element>
 void ClearEvalMultKeys(const CryptoContext<Element> &cryptoCtx) {
-  cryptoCtx->ClearEvalMultKeys();
+  for (const auto &keyTag : GetContextKeyTags(cryptoCtx, CryptoContextImpl<Element>::GetAllEvalMultKeys())) {
+    CryptoContextImpl<Element>::ClearEvalMultKeys(keyTag);
+  }
 }
 
 /**
- * @brief flush EvalAutomorphismKey cache for a given id.
+ * @brief flush the EvalAutomorphismKeys of a given context; other contexts'
+ * keys are kept. The rotation plans of the cleared tags refer to the keys
+ * and are dropped as well.
  * @param cryptoCtx - Reference to CryptoContext from JS.
  */
 template<typename Element>
 void ClearEvalAutomorphismKeys(const CryptoContext<Element> &cryptoCtx) {
-  cryptoCtx->ClearEvalAutomorphismKeys();
+  for (const auto &keyTag : GetContextKeyTags(cryptoCtx, CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys())) {
+    CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(keyTag);
+    ClearRotationPlan(keyTag);
+  }
 }
 
 /**
- * @brief flush EvalSumKey cache.
+ * @brief flush the EvalSumKeys of a given context; other contexts' keys are
+ * kept. OpenFHE stores sum keys with the automorphism keys, so the rotation
+ * plans of the cleared tags are dropped as well.
  * @param cryptoCtx - Reference to CryptoContext from JS.
  */
 template<typename Element>
 void ClearEvalSumKeys(const CryptoContext<Element> &cryptoCtx) {
-  cryptoCtx->ClearEvalSumKeys();
+  for (const auto &keyTag : GetContextKeyTags(cryptoCtx, CryptoContextImpl<Element>::GetAllEvalSumKeys())) {
+    CryptoContextImpl<Element>::ClearEvalSumKeys(keyTag);
+    ClearRotationPlan(keyTag);
+  }
 }
 
 /**
@@ -573,6 +806,169 @@ void DeserializeEvalSumKeyFromBuffer(const CryptoContext<Element> &cryptoCtx,
   }
 }
 
+// Per-tenant variants of the eval-key (de)serializers above. Those pass an
+// empty key tag and so handle the keys of every tenant in the process; these
+// select one key tag and, for rotation keys, optionally a subset of indices.
+
+template<typename Element>
+using EvalKeyMapsByTag = std::map<std::string, std::shared_ptr<std::map<uint32_t, EvalKey<Element>>>>;
+
+/**
+ * @brief Copy of a tag's automorphism key map restricted to some rotations.
+ * @param indexList - JS array of rotation indices, or undefined for all keys.
+ */
+template<typename Element>
+std::shared_ptr<std::map<uint32_t, EvalKey<Element>>> SelectAutomorphismKeys(
+    const CryptoContext<Element> &cryptoCtx,
+    const std::map<uint32_t, EvalKey<Element>> &keys,
+    const emscripten::val &indexList) {
+  if (indexList.isUndefined() || indexList.isNull()) {
+    return std::make_shared<std::map<uint32_t, EvalKey<Element>>>(keys);
+  }
+  auto selected = std::make_shared<std::map<uint32_t, EvalKey<Element>>>();
+  for (const auto autoIndex : cryptoCtx->FindAutomorphismIndices(vecFromJSArray<int32_t>(indexList))) {
+    const auto it = keys.find(autoIndex);
+    if (it == keys.end()) OPENFHE_THROW("no rotation key for automorphism index " + std::to_string(autoIndex));
+    selected->emplace(*it);
+  }
+  return selected;
+}
+
+/**
+ * @brief Serialize the EvalMultKeys of one key tag.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param keyTag - key tag, as returned by GetKeyTag().
+ * @param serType - type of serialization JSON or BINARY.
+ * @return serialized buffer, loadable with DeserializeEvalMultKeyFromBuffer.
+ */
+template<typename Element>
+emscripten::val SerializeEvalMultKeyForTagToBuffer(const CryptoContext<Element> &cryptoCtx,
+                                                   const std::string &keyTag,
+                                                   JsSerType serType) {
+  std::ostringstream outputBuffer;
+  bool found = false;
+
+  if (serType == JsSerType::BINARY) {
+    found = cryptoCtx->SerializeEvalMultKey(outputBuffer, SerType::BINARY, keyTag);
+  } else if (serType == JsSerType::JSON) {
+    found = cryptoCtx->SerializeEvalMultKey(outputBuffer, SerType::JSON, keyTag);
+  }
+  if (!found) OPENFHE_THROW("no EvalMult keys for key tag " + keyTag);
+
+  return stringstreamToTypedArray(outputBuffer);
+}
+
+/**
+ * @brief Serialize the rotation keys of one key tag, optionally only those
+ * for some rotation indices (e.g. the rotations one query needs).
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param keyTag - key tag, as returned by GetKeyTag().
+ * @param indexList - JS array of rotation indices, or undefined for all keys.
+ * @param serType - type of serialization JSON or BINARY.
+ * @return serialized buffer, loadable with DeserializeEvalAutomorphismKeyFromBuffer.
+ */
+template<typename Element>
+emscripten::val SerializeEvalAutomorphismKeyForTagToBuffer(const CryptoContext<Element> &cryptoCtx,
+                                                           const std::string &keyTag,
+                                                           const emscripten::val &indexList,
+                                                           JsSerType serType) {
+  const auto &allKeys = CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys();
+  const auto it = allKeys.find(keyTag);
+  if (it == allKeys.end() || it->second == nullptr) OPENFHE_THROW("no rotation keys for key tag " + keyTag);
+
+  EvalKeyMapsByTag<Element> keyMaps{{keyTag, SelectAutomorphismKeys(cryptoCtx, *it->second, indexList)}};
+  std::ostringstream outputBuffer;
+
+  if (serType == JsSerType::BINARY) {
+    Serial::Serialize(keyMaps, outputBuffer, SerType::BINARY);
+  } else if (serType == JsSerType::JSON) {
+    Serial::Serialize(keyMaps, outputBuffer, SerType::JSON);
+  }
+
+  return stringstreamToTypedArray(outputBuffer);
+}
+
+/**
+ * @brief Serialize the EvalSumKeys of one key tag.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param keyTag - key tag, as returned by GetKeyTag().
+ * @param serType - type of serialization JSON or BINARY.
+ * @return serialized buffer, loadable with DeserializeEvalSumKeyFromBuffer.
+ */
+template<typename Element>
+emscripten::val SerializeEvalSumKeyForTagToBuffer(const CryptoContext<Element> &cryptoCtx,
+                                                  const std::string &keyTag,
+                                                  JsSerType serType) {
+  std::ostringstream outputBuffer;
+  bool found = false;
+
+  if (serType == JsSerType::BINARY) {
+    found = cryptoCtx->SerializeEvalSumKey(outputBuffer, SerType::BINARY, keyTag);
+  } else if (serType == JsSerType::JSON) {
+    found = cryptoCtx->SerializeEvalSumKey(outputBuffer, SerType::JSON, keyTag);
+  }
+  if (!found) OPENFHE_THROW("no EvalSum keys for key tag " + keyTag);
+
+  return stringstreamToTypedArray(outputBuffer);
+}
+
+/**
+ * @brief Load only the EvalMultKeys of one key tag from a serialization that
+ * may hold the keys of several tags; the other tags are not inserted.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param jsBuf (internal) - string with a serialization.
+ * @param keyTag - key tag to load.
+ * @param serType - type of serialization JSON or BINARY.
+ */
+template<typename Element>
+void DeserializeEvalMultKeyForTagFromBuffer(const CryptoContext<Element> &cryptoCtx,
+                                            const emscripten::val &jsBuf,
+                                            const std::string &keyTag,
+                                            JsSerType serType) {
+  auto stream = typedArrayToStringstream(jsBuf);
+  std::map<std::string, std::vector<EvalKey<Element>>> keyVectors;
+
+  if (serType == JsSerType::BINARY) {
+    Serial::Deserialize(keyVectors, stream, SerType::BINARY);
+  } else if (serType == JsSerType::JSON) {
+    Serial::Deserialize(keyVectors, stream, SerType::JSON);
+  }
+
+  const auto it = keyVectors.find(keyTag);
+  if (it == keyVectors.end() || it->second.empty()) OPENFHE_THROW("no EvalMult keys for key tag " + keyTag);
+  cryptoCtx->InsertEvalMultKey(it->second);
+}
+
+/**
+ * @brief Load the rotation keys of one key tag, optionally only those for
+ * some rotation indices, from a serialization that may hold several tags.
+ * Keys already loaded for the tag are kept.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param jsBuf (internal) - string with a serialization.
+ * @param keyTag - key tag to load.
+ * @param indexList - JS array of rotation indices, or undefined for all keys.
+ * @param serType - type of serialization JSON or BINARY.
+ */
+template<typename Element>
+void DeserializeEvalAutomorphismKeyForTagFromBuffer(const CryptoContext<Element> &cryptoCtx,
+                                                    const emscripten::val &jsBuf,
+                                                    const std::string &keyTag,
+                                                    const emscripten::val &indexList,
+                                                    JsSerType serType) {
+  auto stream = typedArrayToStringstream(jsBuf);
+  EvalKeyMapsByTag<Element> keyMaps;
+
+  if (serType == JsSerType::BINARY) {
+    Serial::Deserialize(keyMaps, stream, SerType::BINARY);
+  } else if (serType == JsSerType::JSON) {
+    Serial::Deserialize(keyMaps, stream, SerType::JSON);
+  }
+
+  const auto it = keyMaps.find(keyTag);
+  if (it == keyMaps.end() || it->second == nullptr) OPENFHE_THROW("no rotation keys for key tag " + keyTag);
+  cryptoCtx->InsertEvalAutomorphismKey(SelectAutomorphismKeys(cryptoCtx, *it->second, indexList), keyTag);
+}
+
 // this must be an explicit wrapper method because
 // default arguments don't count as overloads
 
@@ -723,9 +1119,22 @@ int GetBatchSize(const CryptoContext<Element> &cryptoCtx) {
   return cryptoCtx->GetEncodingParams()->GetBatchSize();
 }
 
+/**
+ * @brief The plaintext modulus as a Number, exact up to 2^53.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ */
+template<typename Element>
+double GetPlaintextModulus(const CryptoContext<Element> &cryptoCtx) {
+  return static_cast<double>(cryptoCtx->GetEncodingParams()->GetPlaintextModulus());
+}
+
+/**
+ * @brief The plaintext modulus as a BigInt.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ */
 template<typename Element>
-int GetPlaintextModulus(const CryptoContext<Element> &cryptoCtx) {
-  return cryptoCtx->GetEncodingParams()->GetPlaintextModulus();
+emscripten::val GetPlaintextModulusBigInt(const CryptoContext<Element> &cryptoCtx) {
+  return Uint64ToBigInt(cryptoCtx->GetEncodingParams()->GetPlaintextModulus());
 }
 
 template<typename Element>
@@ -764,69 +1173,133 @@ EMSCRIPTEN_BINDINGS(CryproContext) {
       .constructor(&std::make_shared<CryptoContextImpl<DCRTPoly>>, allow_raw_pointers())
           // ignoring mult-feature Enable() for now
       .function("Enable", select_overload<void(PKESchemeFeature)>(&CC::Enable))
-      .function("Encrypt", &EncryptPKPT<DCRTPoly>)
-      .function("KeyGen", &CC::KeyGen)
-      .function("MultipartyKeyGen", &MultipartyKeyGen<DCRTPoly>)
-      .function("KeySwitchGen", &CC::KeySwitchGen)
-      .function("MultiKeySwitchGen", &CC::MultiKeySwitchGen)
-      .function("MultiAddEvalKeys", &CC::MultiAddEvalKeys)
-      .function("MultiAddEvalMultKeys", &CC::MultiAddEvalMultKeys)
-      .function("MultiAddEvalSumKeys", &CC::MultiAddEvalSumKeys)
-      .function("InsertEvalSumKey", &InsertEvalSumKey<DCRTPoly>)
-      .function("InsertEvalMultKey", &InsertEvalMultKey<DCRTPoly>)
-      .function("MultiMultEvalKey", &CC::MultiMultEvalKey)
-      .function("MultiEvalSumKeyGen", &CC::MultiEvalSumKeyGen)
-      .function("MultipartyDecryptLead", &MultipartyDecryptLead<DCRTPoly>)
-      .function("MultipartyDecryptMain", &MultipartyDecryptMain<DCRTPoly>)
-      .function("MultipartyDecryptFusion", &MultipartyDecryptFusion<DCRTPoly>)
+      .function("Encrypt", Traced<&EncryptPKPT<DCRTPoly>>("Encrypt"))
+      .function("KeyGen", Traced<&CC::KeyGen>("KeyGen"))
+      .function("MultipartyKeyGen", Traced<&MultipartyKeyGen<DCRTPoly>>("MultipartyKeyGen"))
+      .function("KeySwitchGen", Traced<&CC::KeySwitchGen>("KeySwitchGen"))
+      .function("MultiKeySwitchGen", Traced<&CC::MultiKeySwitchGen>("MultiKeySwitchGen"))
+      .function("MultiAddEvalKeys", Traced<&CC::MultiAddEvalKeys>("MultiAddEvalKeys"))
+      .function("MultiAddEvalMultKeys", Traced<&CC::MultiAddEvalMultKeys>("MultiAddEvalMultKeys"))
+      .function("MultiAddEvalSumKeys", Traced<&CC::MultiAddEvalSumKeys>("MultiAddEvalSumKeys"))
+      .function("InsertEvalSumKey", Traced<&InsertEvalSumKey<DCRTPoly>>("InsertEvalSumKey"))
+      .function("InsertEvalMultKey", Traced<&InsertEvalMultKey<DCRTPoly>>("InsertEvalMultKey"))
+      .function("MultiMultEvalKey", Traced<&CC::MultiMultEvalKey>("MultiMultEvalKey"))
+      .function("MultiEvalSumKeyGen", Traced<&CC::MultiEvalSumKeyGen>("MultiEvalSumKeyGen"))
+      .function("MultiEvalAtIndexKeyGen", Traced<&MultiEvalAtIndexKeyGen<DCRTPoly>>("MultiEvalAtIndexKeyGen"))
+          // N-party aggregation of key shares in one call
+      .function("MultiAddEvalKeysBatch", Traced<&MultiAddEvalKeysBatch<DCRTPoly>>("MultiAddEvalKeysBatch"))
+      .function("MultiAddEvalMultKeysBatch", Traced<&MultiAddEvalMultKeysBatch<DCRTPoly>>("MultiAddEvalMultKeysBatch"))
+      .function("MultiAddEvalSumKeysBatch", Traced<&MultiAddEvalSumKeysBatch<DCRTPoly>>("MultiAddEvalSumKeysBatch"))
+      .function("MultiAddEvalAutomorphismKeysBatch",
+                Traced<&MultiAddEvalAutomorphismKeysBatch<DCRTPoly>>("MultiAddEvalAutomorphismKeysBatch"))
+      .function("GetEvalAutomorphismKeyMap", Traced<&GetEvalAutomorphismKeyMap<DCRTPoly>>("GetEvalAutomorphismKeyMap"))
+      .function("InsertEvalAutomorphismKey", Traced<&InsertEvalAutomorphismKey<DCRTPoly>>("InsertEvalAutomorphismKey"))
+      .function("MultipartyDecryptLead", Traced<&MultipartyDecryptLead<DCRTPoly>>("MultipartyDecryptLead"))
+      .function("MultipartyDecryptMain", Traced<&MultipartyDecryptMain<DCRTPoly>>("MultipartyDecryptMain"))
+      .function("MultipartyDecryptFusion", Traced<&MultipartyDecryptFusion<DCRTPoly>>("MultipartyDecryptFusion"))
+      .function("MultipartyDecryptLeadBatch",
+                Traced<&MultipartyDecryptLeadBatch<DCRTPoly>>("MultipartyDecryptLeadBatch"))
+      .function("MultipartyDecryptMainBatch",
+                Traced<&MultipartyDecryptMainBatch<DCRTPoly>>("MultipartyDecryptMainBatch"))
+      .function("MultipartyDecryptFusionBatch",
+                Traced<&MultipartyDecryptFusionBatch<DCRTPoly>>("MultipartyDecryptFusionBatch"))
       .function("GetCryptoParameters", &CC::GetCryptoParameters)
       .function("GetElementParams", &CC::GetElementParams)
-      .function("EvalMultKeyGen", &CC::EvalMultKeyGen)
+      .function("EvalMultKeyGen", Traced<&CC::EvalMultKeyGen>("EvalMultKeyGen"))
           // emscripten DOES support overloading based on # of params
           // 3 args
-      .function("EvalAtIndexKeyGen", &CC::EvalAtIndexKeyGen)
+      .function("EvalAtIndexKeyGen", Traced<&CC::EvalAtIndexKeyGen>("EvalAtIndexKeyGen"))
           // 2 args
-      .function("EvalAtIndexKeyGen", &EvalAtIndexKeyGen<DCRTPoly>)
-      .function("MakePackedPlaintext", &MakePackedPlaintext<DCRTPoly>)
-      .function("MakePackedPlaintext", &MakePackedPlaintextSingle<DCRTPoly>)
-      .function("MakePackedPlaintext", &MakePackedPlaintextZero<DCRTPoly>)
-      .function("MakeCKKSPackedPlaintext", &MakeCKKSPackedPlaintext<DCRTPoly>)
+      .function("EvalAtIndexKeyGen", Traced<&EvalAtIndexKeyGen<DCRTPoly>>("EvalAtIndexKeyGen"))
+      .function("PlanRotationKeys", Traced<&PlanRotationKeys<DCRTPoly>>("PlanRotationKeys"))
+      .function("EvalAtIndexKeyGenPlanned", Traced<&EvalAtIndexKeyGenPlanned<DCRTPoly>>("EvalAtIndexKeyGenPlanned"))
+      .function("MakePackedPlaintext", Traced<&MakePackedPlaintext<DCRTPoly>>("MakePackedPlaintext"))
+      .function("MakePackedPlaintext", Traced<&MakePackedPlaintextSingle<DCRTPoly>>("MakePackedPlaintext"))
+      .function("MakePackedPlaintext", Traced<&MakePackedPlaintextZero<DCRTPoly>>("MakePackedPlaintext"))
+      .function("MakePackedPlaintextInt64", Traced<&MakePackedPlaintextInt64<DCRTPoly>>("MakePackedPlaintextInt64"))
+      .function("MakeCoefPackedPlaintextInt64",
+                Traced<&MakeCoefPackedPlaintextInt64<DCRTPoly>>("MakeCoefPackedPlaintextInt64"))
+      .function("MakeCKKSPackedPlaintext", Traced<&MakeCKKSPackedPlaintext<DCRTPoly>>("MakeCKKSPackedPlaintext"))
+      .function("MakeCKKSComplexPackedPlaintext",
+                Traced<&MakeCKKSComplexPackedPlaintext<DCRTPoly>>("MakeCKKSComplexPackedPlaintext"))
+      .function("EncodeBytes", Traced<&EncodeBytes<DCRTPoly>>("EncodeBytes"))
+      .function("DecodeBytes", Traced<&DecodeBytes<DCRTPoly>>("DecodeBytes"))
+      .function("GetBytesPerPlaintext", Traced<&GetBytesPerPlaintext<DCRTPoly>>("GetBytesPerPlaintext"))
           // select_overload() required because the other overload is deprecated
-      .function("ReEncrypt", &ReEncrypt2<DCRTPoly>)
-      .function("Decrypt", &Decrypt<DCRTPoly>, allow_raw_pointers())
-      .function("EvalAddCipherCipher", EvalAddCipherCipher<DCRTPoly>)
-      .function("EvalMultCipherCipher", EvalMultCipherCipher<DCRTPoly>)
-      .function("EvalMultCipherPlaintext", EvalMultCipherPlaintext<DCRTPoly>)
-      .function("EvalSubCipherCipher", EvalSubCipherCipher<DCRTPoly>)
-      .function("EvalMultCipherConstant", EvalMultCipherConstant<DCRTPoly>)
-      .function("EvalNegate", &EvalNegate<DCRTPoly>)
-      .function("EvalAtIndex", &EvalAtIndex<DCRTPoly>)
-      .function("EvalFastRotationPrecompute", &EvalFastRotationPrecompute<DCRTPoly>)
-      .function("EvalFastRotation", &EvalFastRotation<DCRTPoly>)
-      .function("EvalSum", &EvalSum<DCRTPoly>)
-      .function("EvalInnerProduct", &EvalInnerProduct<DCRTPoly>)
-      .function("EvalMultMany", &EvalMultMany<DCRTPoly>)
-      .function("EvalMerge", &EvalMerge<DCRTPoly>)
-      .function("EvalLinearWSum", &EvalLinearWSum<DCRTPoly>)
-      .function("ModReduce", &ModReduce<DCRTPoly>)
-      .function("EvalSumKeyGen", &EvalSumKeyGen1<DCRTPoly>)
-      .function("GetEvalSumKeyMap", &GetEvalSumKeyMap<DCRTPoly>)
+      .function("ReEncrypt", Traced<&ReEncrypt2<DCRTPoly>>("ReEncrypt"))
+      .function("DecryptByteRecords", Traced<&DecryptByteRecords<DCRTPoly>>("DecryptByteRecords"))
+      .function("DecryptColumnRecords", Traced<&DecryptColumnRecords<DCRTPoly>>("DecryptColumnRecords"))
+      .function("Decrypt", Traced<&Decrypt<DCRTPoly>>("Decrypt"), allow_raw_pointers())
+      .function("EvalAddCipherCipher", Traced<&EvalAddCipherCipher<DCRTPoly>>("EvalAddCipherCipher"))
+      .function("EvalMultCipherCipher", Traced<&EvalMultCipherCipher<DCRTPoly>>("EvalMultCipherCipher"))
+      .function("EvalMultCipherPlaintext", Traced<&EvalMultCipherPlaintext<DCRTPoly>>("EvalMultCipherPlaintext"))
+      .function("EvalSubCipherCipher", Traced<&EvalSubCipherCipher<DCRTPoly>>("EvalSubCipherCipher"))
+      .function("EvalMultCipherConstant", Traced<&EvalMultCipherConstant<DCRTPoly>>("EvalMultCipherConstant"))
+      .function("EvalNegate", Traced<&EvalNegate<DCRTPoly>>("EvalNegate"))
+      .function("EvalAtIndex", Traced<&EvalAtIndex<DCRTPoly>>("EvalAtIndex"))
+      .function("EvalConjugateKeyGen", Traced<&EvalConjugateKeyGen<DCRTPoly>>("EvalConjugateKeyGen"))
+      .function("EvalConjugate", Traced<&EvalConjugate<DCRTPoly>>("EvalConjugate"))
+      .function("EvalRealPart", Traced<&EvalRealPart<DCRTPoly>>("EvalRealPart"))
+      .function("EvalImagPart", Traced<&EvalImagPart<DCRTPoly>>("EvalImagPart"))
+      .function("EvalFastRotationPrecompute",
+                Traced<&EvalFastRotationPrecompute<DCRTPoly>>("EvalFastRotationPrecompute"))
+      .function("EvalFastRotation", Traced<&EvalFastRotation<DCRTPoly>>("EvalFastRotation"))
+      .function("EvalSum", Traced<&EvalSum<DCRTPoly>>("EvalSum"))
+      .function("EvalInnerProduct", Traced<&EvalInnerProduct<DCRTPoly>>("EvalInnerProduct"))
+      .function("EvalMultMany", Traced<&EvalMultMany<DCRTPoly>>("EvalMultMany"))
+      .function("EvalMultNoRelin", Traced<&EvalMultNoRelin<DCRTPoly>>("EvalMultNoRelin"))
+      .function("Relinearize", Traced<&Relinearize<DCRTPoly>>("Relinearize"))
+      .function("RelinearizeInPlace", Traced<&RelinearizeInPlace<DCRTPoly>>("RelinearizeInPlace"))
+      .function("EvalSumOfProducts", Traced<&EvalSumOfProducts<DCRTPoly>>("EvalSumOfProducts"))
+      .function("EvalMerge", Traced<&EvalMerge<DCRTPoly>>("EvalMerge"))
+      .function("EvalLinearWSum", Traced<&EvalLinearWSum<DCRTPoly>>("EvalLinearWSum"))
+      .function("ModReduce", Traced<&ModReduce<DCRTPoly>>("ModReduce"))
+          // in-place variants mutate their first ciphertext argument
+      .function("EvalAddInPlace", Traced<&EvalAddInPlace<DCRTPoly>>("EvalAddInPlace"))
+      .function("EvalSubInPlace", Traced<&EvalSubInPlace<DCRTPoly>>("EvalSubInPlace"))
+      .function("EvalNegateInPlace", Traced<&EvalNegateInPlace<DCRTPoly>>("EvalNegateInPlace"))
+      .function("EvalMultInPlace", Traced<&EvalMultInPlace<DCRTPoly>>("EvalMultInPlace"))
+      .function("ModReduceInPlace", Traced<&ModReduceInPlace<DCRTPoly>>("ModReduceInPlace"))
+      .function("RescaleInPlace", Traced<&RescaleInPlace<DCRTPoly>>("RescaleInPlace"))
+      .function("EvalRotateInPlace", Traced<&EvalRotateInPlace<DCRTPoly>>("EvalRotateInPlace"))
+      .function("EvalSumKeyGen", Traced<&EvalSumKeyGen1<DCRTPoly>>("EvalSumKeyGen"))
+      .function("GetEvalSumKeyMap", Traced<&GetEvalSumKeyMap<DCRTPoly>>("GetEvalSumKeyMap"))
       .function("GetRingDimension", &CC::GetRingDimension)
-      .function("Compress", &Compress<DCRTPoly>)
-      .function("GetBatchSize", &GetBatchSize<DCRTPoly>)
-      .function("GetPlaintextModulus", &GetPlaintextModulus<DCRTPoly>)
+      .function("Compress", Traced<&Compress<DCRTPoly>>("Compress"))
+      .function("GetBatchSize", Traced<&GetBatchSize<DCRTPoly>>("GetBatchSize"))
+      .function("GetPlaintextModulus", Traced<&GetPlaintextModulus<DCRTPoly>>("GetPlaintextModulus"))
+      .function("GetPlaintextModulusBigInt", Traced<&GetPlaintextModulusBigInt<DCRTPoly>>("GetPlaintextModulusBigInt"))
           // serialization
-      .function("ClearEvalMultKeys", ClearEvalMultKeys<DCRTPoly>)
-      .function("ClearEvalAutomorphismKeys", ClearEvalAutomorphismKeys<DCRTPoly>)
-      .function("ClearEvalSumKeys", ClearEvalAutomorphismKeys<DCRTPoly>)
-      .function("SerializeEvalMultKeyToBuffer", &SerializeEvalMultKeyToBuffer<DCRTPoly>)
-      .function("SerializeEvalAutomorphismKeyToBuffer", &SerializeEvalAutomorphismKeyToBuffer<DCRTPoly>)
-      .function("SerializeEvalSumKeyToBuffer", &SerializeEvalSumKeyToBuffer<DCRTPoly>)
-      .function("DeserializeEvalMultKeyFromBuffer", &DeserializeEvalMultKeyFromBuffer<DCRTPoly>)
-      .function("DeserializeEvalAutomorphismKeyFromBuffer", &DeserializeEvalAutomorphismKeyFromBuffer<DCRTPoly>)
-      .function("DeserializeEvalSumKeyFromBuffer", &DeserializeEvalSumKeyFromBuffer<DCRTPoly>)
-      .function("ReKeyGenPrivPub", &ReKeyGenWrapped<DCRTPoly>)
-      .function("ReKeyGenPubPriv", &ReKeyGenWrappedTwo<DCRTPoly>);
+      .function("ClearEvalMultKeys", Traced<&ClearEvalMultKeys<DCRTPoly>>("ClearEvalMultKeys"))
+      .function("ClearEvalAutomorphismKeys", Traced<&ClearEvalAutomorphismKeys<DCRTPoly>>("ClearEvalAutomorphismKeys"))
+      .function("ClearEvalSumKeys", Traced<&ClearEvalSumKeys<DCRTPoly>>("ClearEvalSumKeys"))
+      .function("SerializeEvalMultKeyToBuffer",
+                Traced<&SerializeEvalMultKeyToBuffer<DCRTPoly>>("SerializeEvalMultKeyToBuffer"))
+      .function("SerializeEvalAutomorphismKeyToBuffer",
+                Traced<&SerializeEvalAutomorphismKeyToBuffer<DCRTPoly>>("SerializeEvalAutomorphismKeyToBuffer"))
+      .function("SerializeEvalSumKeyToBuffer",
+                Traced<&SerializeEvalSumKeyToBuffer<DCRTPoly>>("SerializeEvalSumKeyToBuffer"))
+      .function("DeserializeEvalMultKeyFromBuffer",
+                Traced<&DeserializeEvalMultKeyFromBuffer<DCRTPoly>>("DeserializeEvalMultKeyFromBuffer"))
+      .function("DeserializeEvalAutomorphismKeyFromBuffer",
+                Traced<&DeserializeEvalAutomorphismKeyFromBuffer<DCRTPoly>>("DeserializeEvalAutomorphismKeyFromBuffer"))
+      .function("DeserializeEvalSumKeyFromBuffer",
+                Traced<&DeserializeEvalSumKeyFromBuffer<DCRTPoly>>("DeserializeEvalSumKeyFromBuffer"))
+          // single key tag, optionally a subset of rotation indices
+      .function("SerializeEvalMultKeyForTagToBuffer",
+                Traced<&SerializeEvalMultKeyForTagToBuffer<DCRTPoly>>("SerializeEvalMultKeyForTagToBuffer"))
+      .function("SerializeEvalAutomorphismKeyForTagToBuffer",
+                Traced<&SerializeEvalAutomorphismKeyForTagToBuffer<DCRTPoly>>(
+                    "SerializeEvalAutomorphismKeyForTagToBuffer"))
+      .function("SerializeEvalSumKeyForTagToBuffer",
+                Traced<&SerializeEvalSumKeyForTagToBuffer<DCRTPoly>>("SerializeEvalSumKeyForTagToBuffer"))
+      .function("DeserializeEvalMultKeyForTagFromBuffer",
+                Traced<&DeserializeEvalMultKeyForTagFromBuffer<DCRTPoly>>("DeserializeEvalMultKeyForTagFromBuffer"))
+      .function("DeserializeEvalAutomorphismKeyForTagFromBuffer",
+                Traced<&DeserializeEvalAutomorphismKeyForTagFromBuffer<DCRTPoly>>(
+                    "DeserializeEvalAutomorphismKeyForTagFromBuffer"))
+      .function("ReKeyGenPrivPub", Traced<&ReKeyGenWrapped<DCRTPoly>>("ReKeyGenPrivPub"))
+      .function("ReKeyGenPubPriv", Traced<&ReKeyGenWrappedTwo<DCRTPoly>>("ReKeyGenPubPriv"));
 }
 
 // vector<shared_ptr<CiphertextImpl<lbcrypto::DCRTPolyImpl<bigintdyn::mubintvec<bigintdyn::ubint<unsigned int>>>>>>
@@ -0,0 +1,94 @@
+#ifndef _OPENFHEWEB_PKE_BYTE_ENCODING_EM_H
+#define _OPENFHEWEB_PKE_BYTE_ENCODING_EM_H
+
+#include "byte_packing.h"
+#include "pre_pipeline_em.h"
+#include "core/serial_em.h"
+using namespace lbcrypto;
+
+// Encoding of opaque byte payloads into BFV/BGV plaintexts, packing
+// floor(log2 t) bits into each slot (PACKED) or each coefficient
+// (COEF_PACKED). See byte_packing.h for the bit layout.
+enum class BytePacking { PACKED, COEF_PACKED };
+
+/**
+ * @brief Payload bytes one plaintext carries.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param packing - #PACKED or #COEF_PACKED
+ * @return bytes per plaintext.
+ */
+template<typename Element>
+uint32_t GetBytesPerPlaintext(const CryptoContext<Element> &cryptoCtx, BytePacking packing) {
+  const auto bits = BitsPerSlot(cryptoCtx->GetEncodingParams()->GetPlaintextModulus());
+  const auto slots = packing == BytePacking::PACKED ? GetPackedSlots(cryptoCtx) : cryptoCtx->GetRingDimension();
+  return BytesForSlots(slots, bits);
+}
+
+/**
+ * @brief Encode a byte payload into as few plaintexts as possible.
+ * The Uint8Array is copied into the WASM heap once and packed from there.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param jsBuf - payload as a Uint8Array.
+ * @param packing - #PACKED or #COEF_PACKED
+ * @return JS array of plaintexts.
+ */
+template<typename Element>
+emscripten::val EncodeBytes(const CryptoContext<Element> &cryptoCtx,
+                            const emscripten::val &jsBuf,
+                            BytePacking packing) {
+  const auto plaintextModulus = cryptoCtx->GetEncodingParams()->GetPlaintextModulus();
+  const auto bits = BitsPerSlot(plaintextModulus);
+  const size_t bytesPerPlaintext = GetBytesPerPlaintext(cryptoCtx, packing);
+  const auto bytes = typedArrayToString(jsBuf);
+  const auto data = reinterpret_cast<const uint8_t *>(bytes.data());
+
+  auto result = emscripten::val::array();
+  for (size_t offset = 0; offset < bytes.size(); offset += bytesPerPlaintext) {
+    const auto slots = PackBytes(data + offset, std::min(bytesPerPlaintext, bytes.size() - offset),
+                                 plaintextModulus, bits);
+    const auto plaintext = packing == BytePacking::PACKED ? cryptoCtx->MakePackedPlaintext(slots)
+                                                          : cryptoCtx->MakeCoefPackedPlaintext(slots);
+    result.call<void>("push", plaintext);
+  }
+  return result;
+}
+
+/**
+ * @brief Decode plaintexts produced by EncodeBytes(), e.g. after decryption.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param plaintextsJs - JS array of plaintexts, in encoding order.
+ * @param numBytes - payload length.
+ * @param packing - #PACKED or #COEF_PACKED
+ * @return payload as a Uint8Array.
+ */
+template<typename Element>
+emscripten::val DecodeBytes(const CryptoContext<Element> &cryptoCtx,
+                            const emscripten::val &plaintextsJs,
+                            uint32_t numBytes,
+                            BytePacking packing) {
+  const auto plaintextModulus = cryptoCtx->GetEncodingParams()->GetPlaintextModulus();
+  const auto bits = BitsPerSlot(plaintextModulus);
+  const size_t bytesPerPlaintext = GetBytesPerPlaintext(cryptoCtx, packing);
+  const auto plaintexts = vecFromJSArray<Plaintext>(plaintextsJs);
+  if (plaintexts.size() * bytesPerPlaintext < numBytes) OPENFHE_THROW("not enough plaintexts for payload");
+
+  std::string payload(numBytes, '\0');
+  for (size_t i = 0, offset = 0; offset < numBytes; i++, offset += bytesPerPlaintext) {
+    const auto &values = packing == BytePacking::PACKED ? plaintexts[i]->GetPackedValue()
+                                                        : plaintexts[i]->GetCoefPackedValue();
+    UnpackBytes(values, plaintextModulus, bits, reinterpret_cast<uint8_t *>(&payload[offset]),
+                std::min<size_t>(bytesPerPlaintext, numBytes - offset));
+  }
+
+  std::ostringstream outputBuffer;
+  outputBuffer.write(payload.data(), payload.size());
+  return stringstreamToTypedArray(outputBuffer);
+}
+
+EMSCRIPTEN_BINDINGS(byte_encoding) {
+  enum_<BytePacking>("BytePacking")
+      .value("PACKED", BytePacking::PACKED)
+      .value("COEF_PACKED", BytePacking::COEF_PACKED);
+}
+
+#endif
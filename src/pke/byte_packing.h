@@ -0,0 +1,103 @@
+#ifndef _OPENFHEWEB_PKE_BYTE_PACKING_H
+#define _OPENFHEWEB_PKE_BYTE_PACKING_H
+
+#include "openfhe.h"
+using namespace lbcrypto;
+
+// Dense packing of opaque bytes into plaintext slots.
+//
+// Every slot carries floor(log2 t) bits of the byte stream, least significant
+// bit first, so each slot value is below the plaintext modulus t. The
+// encoders take the centered range (-t/2, t/2], so values above t / 2 are
+// stored as v - t and lifted back by UnpackBytes(). With t = 65537 a slot
+// carries 16 bits, twice the one byte per slot of the examples. The width is capped at 56 bits to keep the bit accumulator in a
+// single 64 bit word.
+const uint32_t kMaxBitsPerSlot = 56;
+
+/**
+ * @brief Number of payload bits a slot can carry for a plaintext modulus.
+ * @param plaintextModulus - plaintext modulus t.
+ * @return bits per slot.
+ */
+inline uint32_t BitsPerSlot(PlaintextModulus plaintextModulus) {
+  uint32_t bits = 0;
+  while (bits < 63 && (1ULL << (bits + 1)) <= plaintextModulus) bits++;
+  if (bits == 0) OPENFHE_THROW("plaintext modulus is too small to carry payload bits");
+  return std::min(bits, kMaxBitsPerSlot);
+}
+
+/**
+ * @brief Number of slots needed for a payload.
+ */
+inline size_t SlotsForBytes(size_t numBytes, uint32_t bitsPerSlot) {
+  return (numBytes * 8 + bitsPerSlot - 1) / bitsPerSlot;
+}
+
+/**
+ * @brief Number of whole payload bytes that fit into a number of slots.
+ */
+inline size_t BytesForSlots(size_t numSlots, uint32_t bitsPerSlot) {
+  return numSlots * bitsPerSlot / 8;
+}
+
+/**
+ * @brief Pack bytes into slot values.
+ * @param data - payload.
+ * @param numBytes - payload length.
+ * @param plaintextModulus - plaintext modulus t.
+ * @param bitsPerSlot - bits carried by each slot.
+ * @return centered slot values, the last one zero padded.
+ */
+inline std::vector<int64_t> PackBytes(const uint8_t *data, size_t numBytes, PlaintextModulus plaintextModulus,
+                                      uint32_t bitsPerSlot) {
+  std::vector<int64_t> slots;
+  slots.reserve(SlotsForBytes(numBytes, bitsPerSlot));
+  const uint64_t mask = (1ULL << bitsPerSlot) - 1;
+  const auto center = [plaintextModulus](uint64_t value) {
+    return value > plaintextModulus / 2 ? static_cast<int64_t>(value) - static_cast<int64_t>(plaintextModulus)
+                                              : static_cast<int64_t>(value);
+  };
+  uint64_t acc = 0;
+  uint32_t accBits = 0;
+  for (size_t i = 0; i < numBytes; i++) {
+    acc |= static_cast<uint64_t>(data[i]) << accBits;
+    accBits += 8;
+    while (accBits >= bitsPerSlot) {
+      slots.push_back(center(acc & mask));
+      acc >>= bitsPerSlot;
+      accBits -= bitsPerSlot;
+    }
+  }
+  if (accBits > 0) slots.push_back(center(acc & mask));
+  return slots;
+}
+
+/**
+ * @brief Unpack slot values written by PackBytes().
+ * @param slots - decoded slot values; negative values are centered
+ * representatives and are lifted back to [0, t).
+ * @param plaintextModulus - plaintext modulus t.
+ * @param bitsPerSlot - bits carried by each slot.
+ * @param out - destination, receives numBytes bytes.
+ * @param numBytes - payload length.
+ */
+inline void UnpackBytes(const std::vector<int64_t> &slots, PlaintextModulus plaintextModulus,
+                        uint32_t bitsPerSlot, uint8_t *out, size_t numBytes) {
+  if (slots.size() < SlotsForBytes(numBytes, bitsPerSlot)) OPENFHE_THROW("not enough slots for payload");
+  uint64_t acc = 0;
+  uint32_t accBits = 0;
+  size_t written = 0;
+  for (size_t i = 0; written < numBytes; i++) {
+    int64_t value = slots[i];
+    if (value < 0) value += plaintextModulus;
+    acc |= static_cast<uint64_t>(value) << accBits;
+    accBits += bitsPerSlot;
+    while (accBits >= 8 && written < numBytes) {
+      out[written++] = static_cast<uint8_t>(acc & 0xff);
+      acc >>= 8;
+      accBits -= 8;
+    }
+  }
+}
+
+#endif
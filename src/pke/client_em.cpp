@@ -0,0 +1,137 @@
+// Slim client modules.
+//
+// The full module (CryptoContext_em.cpp) binds every scheme, multiparty, PRE
+// and the serialization of all of them. Browser clients usually only encode,
+// encrypt, decrypt and exchange ciphertexts for one scheme. This file is
+// compiled once per client target, with
+//   OPENFHEWEB_CLIENT_CKKS or OPENFHEWEB_CLIENT_BFV  - the scheme, and
+//   OPENFHEWEB_CLIENT_ENCRYPT_ONLY                    - no key generation or
+//     decryption: the context and the public key are deserialized.
+// embind keeps everything a bindings block refers to, so the slim modules
+// are slim because only the bindings below (and the small core ones) are
+// compiled in; the code of other schemes and features is never referenced
+// and is dropped by the linker. The API is the subset of the full module's.
+
+// OpenFHE Includes
+#include "openfhe.h"
+#include "ciphertext-ser.h"
+#include "cryptocontext-ser.h"
+#include "key/key-ser.h"
+#if defined(OPENFHEWEB_CLIENT_CKKS)
+#include "scheme/ckksrns/ckksrns-ser.h"
+#elif defined(OPENFHEWEB_CLIENT_BFV)
+#include "scheme/bfvrns/bfvrns-ser.h"
+#else
+#error "define OPENFHEWEB_CLIENT_CKKS or OPENFHEWEB_CLIENT_BFV"
+#endif
+using namespace lbcrypto;
+
+// Emscripten includes.
+#include <emscripten.h>
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+using namespace emscripten;
+
+// Local emscripten binding includes.
+#define OPENFHEWEB_SLIM_CLIENT
+#include "core/Plaintext_em.h"
+#include "core/exception_em.h"
+#include "core/version_em.h"
+#include "core/parameters.h"
+#include "pubkeylp_em.h"
+#include "pke_serial_em.h"
+
+#if defined(OPENFHEWEB_CLIENT_CKKS)
+using ClientScheme = CryptoContextCKKSRNS;
+#else
+using ClientScheme = CryptoContextBFVRNS;
+#endif
+
+CryptoContext<DCRTPoly> GenClientCryptoContext(CCParams<ClientScheme> params) { return GenCryptoContext(params); }
+
+#if defined(OPENFHEWEB_CLIENT_CKKS)
+Plaintext MakeCKKSPackedPlaintext(const CryptoContext<DCRTPoly> &cryptoCtx, std::vector<double> values) {
+  return cryptoCtx->MakeCKKSPackedPlaintext(values);
+}
+#else
+Plaintext MakePackedPlaintext(const CryptoContext<DCRTPoly> &cryptoCtx, std::vector<int64_t> values) {
+  return cryptoCtx->MakePackedPlaintext(values);
+}
+#endif
+
+Ciphertext<DCRTPoly> EncryptPKPT(const CryptoContext<DCRTPoly> &cryptoCtx,
+                                 const PublicKey<DCRTPoly> publicKey,
+                                 Plaintext plaintext) {
+  return cryptoCtx->Encrypt(publicKey, plaintext);
+}
+
+#ifndef OPENFHEWEB_CLIENT_ENCRYPT_ONLY
+Plaintext Decrypt(const CryptoContext<DCRTPoly> &cryptoCtx,
+                  const PrivateKey<DCRTPoly> secretKey,
+                  Ciphertext<DCRTPoly> ciphertext) {
+  Plaintext result;
+  cryptoCtx->Decrypt(secretKey, ciphertext, &result);
+  return result;
+}
+#endif
+
+using CC = CryptoContextImpl<DCRTPoly>;
+EMSCRIPTEN_BINDINGS(client) {
+  emscripten::function("SerializeCiphertextToBuffer", &SerializeToBuffer<Ciphertext<DCRTPoly>>);
+  emscripten::function("DeserializeCiphertextFromBuffer", &DeserializeFromBuffer<Ciphertext<DCRTPoly>>);
+  emscripten::function("DeserializeCryptoContextFromBuffer", &DeserializeCryptoContextFromBuffer<DCRTPoly>,
+                       allow_raw_pointers());
+  emscripten::function("DeserializePublicKeyFromBuffer", &DeserializeFromBuffer<PublicKey<DCRTPoly>>);
+  emscripten::function("PrecomputeCRTTablesAfterDeserializaton", &PrecomputeCRTTablesAfterDeserializaton);
+  emscripten::function("EnablePrecomputeCRTTablesAfterDeserializaton", &EnablePrecomputeCRTTablesAfterDeserializaton);
+
+#ifndef OPENFHEWEB_CLIENT_ENCRYPT_ONLY
+  emscripten::function("SerializeCryptoContextToBuffer", &SerializeToBuffer<CryptoContext<DCRTPoly>>,
+                       allow_raw_pointers());
+  emscripten::function("SerializePublicKeyToBuffer", &SerializeToBuffer<PublicKey<DCRTPoly>>, allow_raw_pointers());
+  emscripten::function("SerializePrivateKeyToBuffer", &SerializeToBuffer<PrivateKey<DCRTPoly>>, allow_raw_pointers());
+  emscripten::function("DeserializePrivateKeyFromBuffer", &DeserializeFromBuffer<PrivateKey<DCRTPoly>>);
+
+#if defined(OPENFHEWEB_CLIENT_CKKS)
+  class_<CCParams<ClientScheme>>("CCParamsCryptoContextCKKSRNS")
+      .smart_ptr<std::shared_ptr<CCParams<ClientScheme>>>("CCParamsCryptoContextCKKSRNS")
+      .constructor(&std::make_shared<CCParams<ClientScheme>>, allow_raw_pointers())
+      .function("SetScalingModSize", &SetScalingModSize<ClientScheme>)
+      .function("SetFirstModSize", &SetFirstModSize<ClientScheme>)
+      .function("SetScalingTechnique", &SetScalingTechnique<ClientScheme>)
+#else
+  class_<CCParams<ClientScheme>>("CCParamsCryptoContextBFVRNS")
+      .smart_ptr<std::shared_ptr<CCParams<ClientScheme>>>("CCParamsCryptoContextBFVRNS")
+      .constructor(&std::make_shared<CCParams<ClientScheme>>, allow_raw_pointers())
+      .function("GetPlaintextModulus", &GetWrappedPlaintextModulus<ClientScheme>)
+      .function("SetPlaintextModulus", &SetWrappedPlaintextModulus<ClientScheme>)
+#endif
+      .function("GetMultiplicativeDepth", &GetWrappedMultiplicativeDepth<ClientScheme>)
+      .function("SetMultiplicativeDepth", &SetWrappedMultiplicativeDepth<ClientScheme>)
+      .function("SetSecurityLevel", &SetSecurityLevel<ClientScheme>)
+      .function("SetRingDim", &SetRingDim<ClientScheme>)
+      .function("SetBatchSize", &SetBatchSize<ClientScheme>)
+      .function("toString", &GetString<CCParams<ClientScheme>>);
+
+#if defined(OPENFHEWEB_CLIENT_CKKS)
+  emscripten::function("GenCryptoContextCKKS", &GenClientCryptoContext);
+#else
+  emscripten::function("GenCryptoContextBFV", &GenClientCryptoContext);
+#endif
+#endif
+
+  class_<CC>("CryptoContext_DCRTPoly")
+      .smart_ptr<CryptoContext<DCRTPoly>>("CryptoContext_DCRTPoly")
+      .function("Enable", select_overload<void(PKESchemeFeature)>(&CC::Enable))
+      .function("GetRingDimension", &CC::GetRingDimension)
+#if defined(OPENFHEWEB_CLIENT_CKKS)
+      .function("MakeCKKSPackedPlaintext", &MakeCKKSPackedPlaintext)
+#else
+      .function("MakePackedPlaintext", &MakePackedPlaintext)
+#endif
+#ifndef OPENFHEWEB_CLIENT_ENCRYPT_ONLY
+      .function("KeyGen", &CC::KeyGen)
+      .function("Decrypt", &Decrypt)
+#endif
+      .function("Encrypt", &EncryptPKPT);
+}
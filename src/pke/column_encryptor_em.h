@@ -0,0 +1,204 @@
+#ifndef _OPENFHEWEB_PKE_COLUMN_ENCRYPTOR_EM_H
+#define _OPENFHEWEB_PKE_COLUMN_ENCRYPTOR_EM_H
+
+#include <cmath>
+
+#include "core/serial_em.h"
+#include "core/trace_em.h"
+#include "pre_pipeline_em.h"
+using namespace lbcrypto;
+
+// Streaming encryption of a numeric column.
+//
+// Rows are packed into the slots of CKKS plaintexts (real values) or BFV/BGV
+// plaintexts (integers), encrypted under a public key and serialized one
+// ciphertext at a time, in the same streaming style as BytePREPipeline. The
+// output is a framed stream:
+//
+//   char[8]  magic "OFHECOLS"     (once, at the start of the stream)
+//   uint32   format version
+//   uint32   rows per ciphertext (slots)
+//   per record:
+//     uint64   first row carried by the ciphertext
+//     uint32   rows carried by the ciphertext
+//     uint32   serialized ciphertext length
+//     bytes    binary serialization of the ciphertext
+//
+// Push() consumes a chunk of rows of any length and returns the records of
+// the ciphertexts it completes; at most one ciphertext worth of rows is kept
+// between calls, so memory is bounded by the chunk size. The JS side
+// (EncryptColumnToStream in src/js/column_stream.js) writes the records to a
+// Node stream while the next chunk is encrypted.
+const char kColumnStreamMagic[8] = {'O', 'F', 'H', 'E', 'C', 'O', 'L', 'S'};
+const uint32_t kColumnStreamVersion = 1;
+
+template<typename Element>
+class ColumnEncryptor {
+ public:
+  ColumnEncryptor(CryptoContext<Element> cryptoCtx, PublicKey<Element> publicKey)
+      : m_cryptoCtx(cryptoCtx), m_publicKey(publicKey) {
+    m_realValued = cryptoCtx->getSchemeId() == SCHEME::CKKSRNS_SCHEME;
+    m_rowsPerCiphertext = GetPackedSlots(cryptoCtx);
+    if (m_realValued) m_rowsPerCiphertext = std::min(m_rowsPerCiphertext, cryptoCtx->GetRingDimension() / 2);
+    // integer rows decrypt to the centered range of the plaintext modulus
+    if (!m_realValued) {
+      m_maxAbsRow = static_cast<double>((cryptoCtx->GetEncodingParams()->GetPlaintextModulus() - 1) / 2);
+    }
+    m_pending.reserve(m_rowsPerCiphertext);
+  }
+
+  /**
+   * @brief Feed a chunk of rows.
+   * @param chunk - Float64Array, Int32Array or array of Numbers. With BFV/BGV
+   * the rows have to be integers of absolute value at most (t - 1) / 2.
+   * @return records for the ciphertexts completed by this chunk.
+   */
+  emscripten::val Push(const emscripten::val &chunk) {
+    const auto rows = convertJSArrayToNumberVector<double>(chunk);
+    // checked before any row is buffered, so a rejected chunk leaves the stream as it was
+    if (!m_realValued) {
+      for (size_t i = 0; i < rows.size(); i++) {
+        if (std::trunc(rows[i]) != rows[i] || std::abs(rows[i]) > m_maxAbsRow) {
+          OPENFHE_THROW("row " + std::to_string(static_cast<uint64_t>(m_rowsProcessed) + m_pending.size() + i) +
+                        " is not an integer within the range of the plaintext modulus");
+        }
+      }
+    }
+    std::ostringstream records;
+    WriteStreamHeader(records);
+    size_t offset = 0;
+    while (offset < rows.size()) {
+      const auto take = std::min(rows.size() - offset, static_cast<size_t>(m_rowsPerCiphertext) - m_pending.size());
+      m_pending.insert(m_pending.end(), rows.begin() + offset, rows.begin() + offset + take);
+      offset += take;
+      if (m_pending.size() == m_rowsPerCiphertext) EmitPending(records);
+    }
+    return stringstreamToTypedArray(records);
+  }
+
+  /**
+   * @brief Flush the last, partially filled ciphertext.
+   * @return the remaining record (and the stream header if nothing was
+   * written yet), or an empty Uint8Array.
+   */
+  emscripten::val Finish() {
+    std::ostringstream records;
+    WriteStreamHeader(records);
+    if (!m_pending.empty()) EmitPending(records);
+    return stringstreamToTypedArray(records);
+  }
+
+  uint32_t GetRowsPerCiphertext() const { return m_rowsPerCiphertext; }
+  double GetRowsProcessed() const { return m_rowsProcessed; }
+
+ private:
+  void WriteStreamHeader(std::ostream &records) {
+    if (m_headerWritten) return;
+    records.write(kColumnStreamMagic, sizeof(kColumnStreamMagic));
+    WriteRaw<uint32_t>(records, kColumnStreamVersion);
+    WriteRaw<uint32_t>(records, m_rowsPerCiphertext);
+    m_headerWritten = true;
+  }
+
+  void EmitPending(std::ostream &records) {
+    Ciphertext<Element> ciphertext;
+    {
+      TraceSpan span("Encrypt", "openfhe");
+      Plaintext plaintext;
+      if (m_realValued) {
+        plaintext = m_cryptoCtx->MakeCKKSPackedPlaintext(m_pending);
+      } else {
+        plaintext = m_cryptoCtx->MakePackedPlaintext(std::vector<int64_t>(m_pending.begin(), m_pending.end()));
+      }
+      ciphertext = m_cryptoCtx->Encrypt(m_publicKey, plaintext);
+    }
+
+    std::ostringstream serialized;
+    {
+      TraceSpan span("Serialize", "openfhe");
+      Serial::Serialize(ciphertext, serialized, SerType::BINARY);
+    }
+    const auto serializedStr = serialized.str();
+
+    WriteRaw<uint64_t>(records, static_cast<uint64_t>(m_rowsProcessed));
+    WriteRaw<uint32_t>(records, m_pending.size());
+    WriteRaw<uint32_t>(records, serializedStr.size());
+    records.write(serializedStr.data(), serializedStr.size());
+
+    m_rowsProcessed += m_pending.size();
+    m_pending.clear();
+  }
+
+  CryptoContext<Element> m_cryptoCtx;
+  PublicKey<Element> m_publicKey;
+  bool m_realValued;
+  double m_maxAbsRow = 0;
+  uint32_t m_rowsPerCiphertext;
+  std::vector<double> m_pending;
+  double m_rowsProcessed = 0;
+  bool m_headerWritten = false;
+};
+
+/**
+ * @brief Decrypt a column stream written by ColumnEncryptor back into rows.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param secretKey - secret key matching the encryptor's public key.
+ * @param recordsJs - the stream as a Uint8Array.
+ * @return the rows as a Float64Array.
+ */
+template<typename Element>
+emscripten::val DecryptColumnRecords(const CryptoContext<Element> &cryptoCtx,
+                                     const PrivateKey<Element> secretKey,
+                                     const emscripten::val &recordsJs) {
+  auto stream = typedArrayToStringstream(recordsJs);
+  char magic[sizeof(kColumnStreamMagic)];
+  if (!stream.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), kColumnStreamMagic)) {
+    OPENFHE_THROW("not a column stream");
+  }
+  if (ReadRaw<uint32_t>(stream) != kColumnStreamVersion) OPENFHE_THROW("unsupported column stream version");
+  ReadRaw<uint32_t>(stream);  // rows per ciphertext
+
+  const bool realValued = cryptoCtx->getSchemeId() == SCHEME::CKKSRNS_SCHEME;
+  std::vector<double> rows;
+  while (stream.peek() != std::char_traits<char>::eof()) {
+    const auto firstRow = ReadRaw<uint64_t>(stream);
+    const auto numRows = ReadRaw<uint32_t>(stream);
+    std::string serialized(ReadRaw<uint32_t>(stream), '\0');
+    if (!stream.read(&serialized[0], serialized.size())) OPENFHE_THROW("unexpected end of buffer");
+    if (firstRow != rows.size()) OPENFHE_THROW("column stream records are out of order");
+
+    Ciphertext<Element> ciphertext;
+    std::istringstream serializedStream(serialized);
+    Serial::Deserialize(ciphertext, serializedStream, SerType::BINARY);
+
+    Plaintext plaintext;
+    cryptoCtx->Decrypt(secretKey, ciphertext, &plaintext);
+    plaintext->SetLength(numRows);
+    if (realValued) {
+      const auto values = plaintext->GetRealPackedValue();
+      rows.insert(rows.end(), values.begin(), values.end());
+    } else {
+      const auto &values = plaintext->GetPackedValue();
+      rows.insert(rows.end(), values.begin(), values.end());
+    }
+  }
+  return val::global("Float64Array").new_(emscripten::typed_memory_view(rows.size(), rows.data()));
+}
+
+template<typename Element>
+std::shared_ptr<ColumnEncryptor<Element>> MakeColumnEncryptor(CryptoContext<Element> cryptoCtx,
+                                                              PublicKey<Element> publicKey) {
+  return std::make_shared<ColumnEncryptor<Element>>(cryptoCtx, publicKey);
+}
+
+EMSCRIPTEN_BINDINGS(column_encryptor) {
+  class_<ColumnEncryptor<DCRTPoly>>("ColumnEncryptor")
+      .smart_ptr<std::shared_ptr<ColumnEncryptor<DCRTPoly>>>("ColumnEncryptor")
+      .constructor(Traced<&MakeColumnEncryptor<DCRTPoly>>("ColumnEncryptor"))
+      .function("Push", Traced<&ColumnEncryptor<DCRTPoly>::Push>("ColumnEncryptor.Push"))
+      .function("Finish", Traced<&ColumnEncryptor<DCRTPoly>::Finish>("ColumnEncryptor.Finish"))
+      .function("GetRowsPerCiphertext", &ColumnEncryptor<DCRTPoly>::GetRowsPerCiphertext)
+      .function("GetRowsProcessed", &ColumnEncryptor<DCRTPoly>::GetRowsProcessed);
+}
+
+#endif
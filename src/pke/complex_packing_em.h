@@ -0,0 +1,90 @@
+#ifndef _OPENFHEWEB_PKE_COMPLEX_PACKING_EM_H
+#define _OPENFHEWEB_PKE_COMPLEX_PACKING_EM_H
+
+#include "core/openfhe_em.h"
+#include "core/trace_em.h"
+using namespace lbcrypto;
+
+// Complex-valued CKKS slots. Values cross the boundary as interleaved
+// Float64Arrays [re0, im0, re1, im1, ...], which have the memory layout of
+// std::vector<std::complex<double>>, so encoding and decoding are one copy.
+// Two real vectors a and b can share a ciphertext as a + ib and be separated
+// again with EvalRealPart()/EvalImagPart(), which need the conjugation key of
+// EvalConjugateKeyGen().
+
+/**
+ * @brief constructs a CKKSPackedEncoding in this context
+ * from a vector of complex numbers
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param values - interleaved re/im values, see MakeVectorComplex().
+ * @return plaintext
+ */
+template<typename Element>
+Plaintext MakeCKKSComplexPackedPlaintext(const CryptoContext<Element> &cryptoCtx, const emscripten::val &values) {
+  return cryptoCtx->MakeCKKSPackedPlaintext(MakeVectorComplex(values));
+}
+
+/**
+ * @brief Automorphism index of complex conjugation, 2N - 1.
+ */
+template<typename Element>
+usint GetConjugateIndex(const CryptoContext<Element> &cryptoCtx) {
+  return cryptoCtx->GetCyclotomicOrder() - 1;
+}
+
+/**
+ * @brief Generates the conjugation key and adds it to the automorphism keys
+ * of the secret key's tag.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param privateKey - private key.
+ */
+template<typename Element>
+void EvalConjugateKeyGen(const CryptoContext<Element> &cryptoCtx, const PrivateKey<Element> privateKey) {
+  const auto keys = cryptoCtx->EvalAutomorphismKeyGen(privateKey, {GetConjugateIndex(cryptoCtx)});
+  cryptoCtx->InsertEvalAutomorphismKey(keys, privateKey->GetKeyTag());
+}
+
+/**
+ * @brief Complex conjugate of every slot.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertext - input ciphertext.
+ * @return conjugated ciphertext.
+ */
+template<typename Element>
+Ciphertext<Element> EvalConjugate(const CryptoContext<Element> &cryptoCtx, Ciphertext<Element> ciphertext) {
+  TraceSpan span("Automorphism", "openfhe");
+  const auto &keys = cryptoCtx->GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+  return cryptoCtx->EvalAutomorphism(ciphertext, GetConjugateIndex(cryptoCtx), keys);
+}
+
+/**
+ * @brief Real parts of the slots, (z + conj(z)) / 2.
+ * Consumes one scalar multiplication; with FIXEDMANUAL scaling the result
+ * has to be rescaled like any other product.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertext - input ciphertext.
+ * @return ciphertext with real slots.
+ */
+template<typename Element>
+Ciphertext<Element> EvalRealPart(const CryptoContext<Element> &cryptoCtx, Ciphertext<Element> ciphertext) {
+  auto sum = cryptoCtx->EvalAdd(ciphertext, EvalConjugate(cryptoCtx, ciphertext));
+  return cryptoCtx->EvalMult(sum, 0.5);
+}
+
+/**
+ * @brief Imaginary parts of the slots, (z - conj(z)) / 2i, as real values.
+ * Multiplies by the plaintext constant -i/2 at the ciphertext's level, so it
+ * consumes one level like EvalRealPart().
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertext - input ciphertext.
+ * @return ciphertext with real slots.
+ */
+template<typename Element>
+Ciphertext<Element> EvalImagPart(const CryptoContext<Element> &cryptoCtx, Ciphertext<Element> ciphertext) {
+  auto difference = cryptoCtx->EvalSub(ciphertext, EvalConjugate(cryptoCtx, ciphertext));
+  const std::vector<std::complex<double>> halfNegI(cryptoCtx->GetEncodingParams()->GetBatchSize(), {0, -0.5});
+  const auto constant = cryptoCtx->MakeCKKSPackedPlaintext(halfNegI, 1, ciphertext->GetLevel());
+  return cryptoCtx->EvalMult(difference, constant);
+}
+
+#endif
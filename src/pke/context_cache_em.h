@@ -0,0 +1,311 @@
+#ifndef _OPENFHEWEB_PKE_CONTEXT_CACHE_EM_H
+#define _OPENFHEWEB_PKE_CONTEXT_CACHE_EM_H
+
+#include <unordered_map>
+
+#include "core/serial_em.h"
+#include "pke_serial_em.h"
+#include "globals.h"
+#include "core/trace_em.h"
+using namespace lbcrypto;
+
+// Deserialized CryptoContexts keyed by a hash of their serialized bytes.
+// A service that receives the same context many times only pays for parsing
+// once; later calls compare the bytes against the cached copy and return the
+// cached context directly. The cache holds at most
+// SetCryptoContextCacheLimit() entries and drops the least recently used one
+// beyond that; contexts evicted by the key budget leave the cache as well.
+//
+// CRT table precomputation is chosen per call instead of through the
+// process-global PrecomputeCRTTablesAfterDeserializaton() switch:
+//   EAGER      - tables are built while the context is parsed.
+//   LAZY       - tables are built by the first traced binding that uses the
+//                context, or by EnsureCRTTables().
+//   BACKGROUND - tables are built on the next turn of the JS event loop,
+//                after the deserializing call has returned, or on first use
+//                if that comes earlier.
+// AreCRTTablesReady() tells whether the tables of a context are built.
+enum class CRTPrecomputePolicy { EAGER, LAZY, BACKGROUND };
+
+template<typename Element>
+struct CachedCryptoContext {
+  std::string bytes;
+  CryptoContext<Element> cc;
+  uint64_t lastUse;
+};
+
+template<typename Element>
+std::unordered_multimap<uint64_t, CachedCryptoContext<Element>> &GetCryptoContextCache() {
+  static std::unordered_multimap<uint64_t, CachedCryptoContext<Element>> cache;
+  return cache;
+}
+
+/**
+ * @brief Contexts whose CRT tables are not built yet, keyed by address. The
+ * weak pointer tells a pending context from a later one at the same address.
+ */
+template<typename Element>
+std::unordered_map<const void *, std::weak_ptr<CryptoContextImpl<Element>>> &GetPendingCRTTables() {
+  static std::unordered_map<const void *, std::weak_ptr<CryptoContextImpl<Element>>> pending;
+  return pending;
+}
+
+struct CryptoContextCacheStats {
+  uint32_t limit = 64;  // entries, 0 for no limit
+  uint64_t clock = 0;
+  uint32_t hits = 0;
+  uint32_t misses = 0;
+  uint32_t evictions = 0;
+};
+
+CryptoContextCacheStats &GetCryptoContextCacheStatsRef() {
+  static CryptoContextCacheStats stats;
+  return stats;
+}
+
+/**
+ * @brief 64 bit FNV-1a hash of a byte string.
+ * @param bytes - input bytes.
+ * @return hash value.
+ */
+uint64_t HashBytes(const std::string &bytes) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (unsigned char c : bytes) {
+    hash ^= c;
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+/**
+ * @brief Build the CRT tables of a context, as deserialization does when
+ * PrecomputeCRTTablesAfterDeserializaton() is enabled.
+ * @param cc - CryptoContext whose tables are built.
+ */
+template<typename Element>
+void PrecomputeCRTTablesForContext(const CryptoContext<Element> &cc) {
+  TraceSpan span("PrecomputeCRTTables", "openfhe");
+  auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cc->GetCryptoParameters());
+  if (cryptoParams == nullptr) return;
+  cryptoParams->PrecomputeCRTTables(cryptoParams->GetKeySwitchTechnique(),
+                                    cryptoParams->GetScalingTechnique(),
+                                    cryptoParams->GetEncryptionTechnique(),
+                                    cryptoParams->GetMultiplicationTechnique(),
+                                    cryptoParams->GetNumPartQ(),
+                                    cryptoParams->GetAuxBits(),
+                                    cryptoParams->GetExtraBits());
+}
+
+/**
+ * @brief Build the tables of a pending context when a traced binding first
+ * uses it.
+ * @param object - object the binding was called on or with.
+ */
+template<typename Element>
+void BuildPendingCRTTables(const void *object) {
+  auto &pending = GetPendingCRTTables<Element>();
+  const auto it = pending.find(object);
+  if (it == pending.end()) return;
+  const auto cc = it->second.lock();
+  if (cc != nullptr) PrecomputeCRTTablesForContext<Element>(cc);
+  pending.erase(object);
+  if (pending.empty()) GetFirstUseHook() = nullptr;
+}
+
+/**
+ * @brief Leave the CRT tables of a context to its first use.
+ * @param cc - CryptoContext parsed without its tables.
+ */
+template<typename Element>
+void DeferCRTTables(const CryptoContext<Element> &cc) {
+  auto &pending = GetPendingCRTTables<Element>();
+  // contexts released before their first use
+  for (auto it = pending.begin(); it != pending.end();) {
+    it = it->second.expired() ? pending.erase(it) : std::next(it);
+  }
+  pending[cc.get()] = cc;
+  GetFirstUseHook() = &BuildPendingCRTTables<Element>;
+}
+
+/**
+ * @brief Whether the CRT tables of a context are built.
+ * @param cc - CryptoContext from JS.
+ * @return false while a LAZY or BACKGROUND load has left them to first use.
+ */
+template<typename Element>
+bool AreCRTTablesReady(const CryptoContext<Element> &cc) {
+  const auto &pending = GetPendingCRTTables<Element>();
+  const auto it = pending.find(cc.get());
+  return it == pending.end() || it->second.lock() != cc;
+}
+
+/**
+ * @brief Build the CRT tables of a context deserialized with the LAZY or
+ * BACKGROUND policy, if they are not built yet.
+ * @param cc - CryptoContext from JS.
+ */
+template<typename Element>
+void EnsureCRTTables(const CryptoContext<Element> &cc) {
+  BuildPendingCRTTables<Element>(cc.get());
+}
+
+template<typename Element>
+void EnsureCRTTablesAsync(void *arg) {
+  auto cc = static_cast<CryptoContext<Element> *>(arg);
+  EnsureCRTTables(*cc);
+  delete cc;
+}
+
+/**
+ * @brief Drop the least recently used cache entries beyond the limit.
+ */
+template<typename Element>
+void TrimCryptoContextCache() {
+  auto &cache = GetCryptoContextCache<Element>();
+  auto &stats = GetCryptoContextCacheStatsRef();
+  while (stats.limit > 0 && cache.size() > stats.limit) {
+    auto oldest = cache.begin();
+    for (auto it = cache.begin(); it != cache.end(); ++it) {
+      if (it->second.lastUse < oldest->second.lastUse) oldest = it;
+    }
+    cache.erase(oldest);
+    stats.evictions++;
+  }
+}
+
+/**
+ * @brief Deserialize a CryptoContext, register it with the
+ * CryptoContextFactory and build its CRT tables per policy.
+ * @param stream - serialized CryptoContext.
+ * @param serType - #BINARY or #JSON
+ * @param policy - when to build the CRT tables of the context.
+ * @return nullptr - in case of exception.
+ * @return CryptoContext.
+ */
+template<typename Element>
+CryptoContext<Element> DeserializeCryptoContextWithPolicy(std::istream &stream, JsSerType serType,
+                                                          CRTPrecomputePolicy policy) {
+  const bool precomputeGlobal = PrecomputeCRTTablesAfterDeserializaton();
+  if (policy == CRTPrecomputePolicy::EAGER) {
+    EnablePrecomputeCRTTablesAfterDeserializaton();
+  } else {
+    DisablePrecomputeCRTTablesAfterDeserializaton();
+  }
+
+  auto parsedCC = ParseCryptoContextFromStream<Element>(stream, serType);
+
+  if (precomputeGlobal) {
+    EnablePrecomputeCRTTablesAfterDeserializaton();
+  } else {
+    DisablePrecomputeCRTTablesAfterDeserializaton();
+  }
+  if (parsedCC == nullptr) return nullptr;
+
+  auto getCC = CryptoContextFactory<Element>::GetContext(parsedCC->GetCryptoParameters(), parsedCC->GetScheme(),
+                                                         parsedCC->getSchemeId());
+
+  // the factory may hand back an equal context created earlier; it keeps its
+  // own tables, which are built unless it came from a LAZY/BACKGROUND load
+  // that has not been used yet
+  if (getCC == parsedCC && policy != CRTPrecomputePolicy::EAGER) {
+    DeferCRTTables(getCC);
+    if (policy == CRTPrecomputePolicy::BACKGROUND) {
+      emscripten_async_call(&EnsureCRTTablesAsync<Element>, new CryptoContext<Element>(getCC), 0);
+    }
+  }
+  return getCC;
+}
+
+/**
+ * @brief Deserialize a CryptoContext, reusing the cached instance when the
+ * same bytes were deserialized before.
+ * @param jsBuf - input object as a buffer.
+ * @param serType - #BINARY or #JSON
+ * @param policy - when to build the CRT tables of the context, if they are
+ * not built yet (also on a cache hit).
+ * @return nullptr - in case of exception.
+ * @return CryptoContext.
+ */
+template<typename Element>
+CryptoContext<Element> DeserializeCryptoContextFromBufferCached(const emscripten::val &jsBuf,
+                                                                JsSerType serType,
+                                                                CRTPrecomputePolicy policy) {
+  auto bytes = typedArrayToString(jsBuf);
+  const auto hash = HashBytes(bytes);
+
+  auto &cache = GetCryptoContextCache<Element>();
+  auto &stats = GetCryptoContextCacheStatsRef();
+  auto range = cache.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second.bytes == bytes) {
+      stats.hits++;
+      it->second.lastUse = ++stats.clock;
+      // an earlier LAZY/BACKGROUND load may have left the tables unbuilt
+      auto cached = it->second.cc;
+      if (!AreCRTTablesReady(cached)) {
+        if (policy == CRTPrecomputePolicy::EAGER) {
+          EnsureCRTTables(cached);
+        } else if (policy == CRTPrecomputePolicy::BACKGROUND) {
+          emscripten_async_call(&EnsureCRTTablesAsync<Element>, new CryptoContext<Element>(cached), 0);
+        }
+      }
+      return cached;
+    }
+  }
+  stats.misses++;
+
+  std::istringstream stream(bytes);
+  auto getCC = DeserializeCryptoContextWithPolicy<Element>(stream, serType, policy);
+  if (getCC == nullptr) return nullptr;
+
+  cache.emplace(hash, CachedCryptoContext<Element>{std::move(bytes), getCC, ++stats.clock});
+  TrimCryptoContextCache<Element>();
+  return getCC;
+}
+
+/**
+ * @brief Drop every cached context. Contexts still referenced from JS or
+ * from the CryptoContextFactory stay alive.
+ */
+void ClearCryptoContextCache() {
+  GetCryptoContextCache<DCRTPoly>().clear();
+}
+
+/**
+ * @brief Set how many serialized contexts the cache keeps.
+ * @param limit - number of entries, 0 for no limit.
+ */
+void SetCryptoContextCacheLimit(uint32_t limit) {
+  GetCryptoContextCacheStatsRef().limit = limit;
+  TrimCryptoContextCache<DCRTPoly>();
+}
+
+uint32_t GetCryptoContextCacheLimit() { return GetCryptoContextCacheStatsRef().limit; }
+
+uint32_t GetCryptoContextCacheSize() { return GetCryptoContextCache<DCRTPoly>().size(); }
+
+uint32_t GetCryptoContextCacheHits() { return GetCryptoContextCacheStatsRef().hits; }
+
+uint32_t GetCryptoContextCacheMisses() { return GetCryptoContextCacheStatsRef().misses; }
+
+uint32_t GetCryptoContextCacheEvictions() { return GetCryptoContextCacheStatsRef().evictions; }
+
+EMSCRIPTEN_BINDINGS(context_cache) {
+  enum_<CRTPrecomputePolicy>("CRTPrecomputePolicy")
+      .value("EAGER", CRTPrecomputePolicy::EAGER)
+      .value("LAZY", CRTPrecomputePolicy::LAZY)
+      .value("BACKGROUND", CRTPrecomputePolicy::BACKGROUND);
+  emscripten::function("DeserializeCryptoContextFromBufferCached",
+                       &DeserializeCryptoContextFromBufferCached<DCRTPoly>, allow_raw_pointers());
+  emscripten::function("EnsureCRTTables", &EnsureCRTTables<DCRTPoly>);
+  emscripten::function("AreCRTTablesReady", &AreCRTTablesReady<DCRTPoly>);
+  emscripten::function("ClearCryptoContextCache", &ClearCryptoContextCache);
+  emscripten::function("SetCryptoContextCacheLimit", &SetCryptoContextCacheLimit);
+  emscripten::function("GetCryptoContextCacheLimit", &GetCryptoContextCacheLimit);
+  emscripten::function("GetCryptoContextCacheSize", &GetCryptoContextCacheSize);
+  emscripten::function("GetCryptoContextCacheHits", &GetCryptoContextCacheHits);
+  emscripten::function("GetCryptoContextCacheMisses", &GetCryptoContextCacheMisses);
+  emscripten::function("GetCryptoContextCacheEvictions", &GetCryptoContextCacheEvictions);
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef _OPENFHEWEB_PKE_ELEMENT_CODEC_H
+#define _OPENFHEWEB_PKE_ELEMENT_CODEC_H
+
+#include "core/bitpack.h"
+#include "core/serial_em.h"
+#include "openfhe.h"
+using namespace lbcrypto;
+
+// Building blocks for binary ciphertext formats that are exchanged between
+// parties holding the same CryptoContext. Moduli and roots of unity are not
+// written; the reader takes them from its own context, so only the metadata
+// of the ciphertext and the tower coefficients travel.
+
+/**
+ * @brief Element params made of the first numTowers towers of the context.
+ * Ciphertexts at lower levels use a prefix of the full moduli chain.
+ * @param cryptoCtx - CryptoContext both sides share.
+ * @param numTowers - number of towers.
+ * @return element params.
+ */
+template<typename Element>
+std::shared_ptr<typename Element::Params> GetElementParamsPrefix(const CryptoContext<Element> &cryptoCtx,
+                                                                 uint32_t numTowers) {
+  const auto fullParams = cryptoCtx->GetElementParams();
+  const auto &towers = fullParams->GetParams();
+  if (numTowers > towers.size()) OPENFHE_THROW("ciphertext has more towers than the context");
+  if (numTowers == towers.size()) return fullParams;
+
+  std::vector<NativeInteger> moduli, roots;
+  for (uint32_t i = 0; i < numTowers; i++) {
+    moduli.push_back(towers[i]->GetModulus());
+    roots.push_back(towers[i]->GetRootOfUnity());
+  }
+  return std::make_shared<typename Element::Params>(fullParams->GetCyclotomicOrder(), moduli, roots);
+}
+
+/**
+ * @brief Write the ciphertext metadata needed to decrypt or keep evaluating.
+ */
+template<typename Element>
+void WriteCiphertextMetadata(std::ostream &os, const CiphertextImpl<Element> &ciphertext) {
+  WriteRaw<uint8_t>(os, static_cast<uint8_t>(ciphertext.GetEncodingType()));
+  WriteRaw<uint32_t>(os, ciphertext.GetLevel());
+  WriteRaw<uint32_t>(os, ciphertext.GetNoiseScaleDeg());
+  WriteRaw<double>(os, ciphertext.GetScalingFactor());
+  WriteRaw<uint64_t>(os, ciphertext.GetScalingFactorInt().ConvertToInt());
+  WriteRaw<uint32_t>(os, ciphertext.GetSlots());
+}
+
+/**
+ * @brief Read metadata written by WriteCiphertextMetadata() into a ciphertext.
+ */
+template<typename Element>
+void ReadCiphertextMetadata(std::istream &is, CiphertextImpl<Element> &ciphertext) {
+  ciphertext.SetEncodingType(static_cast<PlaintextEncodings>(ReadRaw<uint8_t>(is)));
+  ciphertext.SetLevel(ReadRaw<uint32_t>(is));
+  ciphertext.SetNoiseScaleDeg(ReadRaw<uint32_t>(is));
+  ciphertext.SetScalingFactor(ReadRaw<double>(is));
+  ciphertext.SetScalingFactorInt(NativeInteger(ReadRaw<uint64_t>(is)));
+  ciphertext.SetSlots(ReadRaw<uint32_t>(is));
+}
+
+/**
+ * @brief Write the towers of a DCRTPoly, each coefficient packed to the bit
+ * width of its tower modulus.
+ */
+inline void WritePackedElement(std::ostream &os, const DCRTPoly &element) {
+  WriteRaw<uint8_t>(os, static_cast<uint8_t>(element.GetFormat()));
+  WriteRaw<uint32_t>(os, element.GetNumOfElements());
+  std::string packed;
+  for (const auto &tower : element.GetAllElements()) {
+    const auto bits = tower.GetModulus().GetMSB();
+    const auto &values = tower.GetValues();
+    packed.clear();
+    packed.reserve((static_cast<size_t>(values.GetLength()) * bits + 7) / 8);
+    BitWriter writer(packed);
+    for (usint j = 0; j < values.GetLength(); j++) {
+      writer.Write(values[j].ConvertToInt(), bits);
+    }
+    writer.Flush();
+    WriteRaw<uint8_t>(os, static_cast<uint8_t>(bits));
+    os.write(packed.data(), packed.size());
+  }
+}
+
+/**
+ * @brief Read a DCRTPoly written by WritePackedElement().
+ * @param is - input stream.
+ * @param cryptoCtx - CryptoContext the element belongs to.
+ * @return the element.
+ */
+template<typename Element>
+DCRTPoly ReadPackedElement(std::istream &is, const CryptoContext<Element> &cryptoCtx) {
+  const auto format = static_cast<Format>(ReadRaw<uint8_t>(is));
+  const auto numTowers = ReadRaw<uint32_t>(is);
+  const auto params = GetElementParamsPrefix(cryptoCtx, numTowers);
+  const auto ringDim = params->GetRingDimension();
+
+  DCRTPoly element(params, format, true);
+  auto &towers = element.GetAllElements();
+  std::string packed;
+  for (uint32_t i = 0; i < numTowers; i++) {
+    const auto bits = ReadRaw<uint8_t>(is);
+    packed.resize((static_cast<size_t>(ringDim) * bits + 7) / 8);
+    if (!is.read(&packed[0], packed.size())) OPENFHE_THROW("unexpected end of buffer");
+
+    BitReader reader(reinterpret_cast<const uint8_t *>(packed.data()), packed.size());
+    NativeVector values(ringDim, towers[i].GetModulus());
+    for (usint j = 0; j < ringDim; j++) {
+      values[j] = NativeInteger(reader.Read(bits));
+    }
+    towers[i].SetValues(std::move(values), format);
+  }
+  return element;
+}
+
+#endif
@@ -0,0 +1,294 @@
+#ifndef _OPENFHEWEB_PKE_KEY_BUDGET_EM_H
+#define _OPENFHEWEB_PKE_KEY_BUDGET_EM_H
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+#include "openfhe.h"
+#include "context_cache_em.h"
+using namespace lbcrypto;
+
+// Memory budget for evaluation keys of many tenants in one module.
+//
+// OpenFHE keeps relinearization and rotation keys in process-wide maps keyed
+// by the secret key's tag, so every tenant's keys stay resident until they
+// are cleared. Key tags touched with TouchEvalKeys() are tracked in LRU order:
+// when the tracked keys exceed the budget, the least recently used tags are
+// evicted (their keys are cleared from the OpenFHE maps), and when more
+// contexts than the context limit are in use, the least recently used
+// context is evicted with all of its tags and its context cache entries.
+//
+// Evicted tags stay tracked, also when their context was evicted, and their
+// keys are brought back from their serialized form by the reloader installed
+// with SetEvalKeyReloader() (see src/js/key_reloader.js) when EnsureEvalKeys()
+// is called for the tag. Rotation plans survive eviction, since they only
+// refer to the key indices.
+//
+// The resident byte count is kept up to date incrementally: a touch only
+// measures the keys of the touched tag, which may have been generated,
+// deserialized or reloaded since its last touch. Keys cleared directly (e.g.
+// with ClearEvalKeysForTag) stay counted until their tag is touched again or
+// untracked.
+
+template<typename Element>
+struct TrackedKeyTag {
+  CryptoContext<Element> cc;
+  uint64_t lastUse = 0;
+  size_t bytes = 0;
+  bool evicted = false;
+};
+
+struct KeyBudgetStats {
+  double budget = 0;  // bytes, 0 for no limit
+  uint32_t contextLimit = 0;  // 0 for no limit
+  uint64_t clock = 0;
+  double residentBytes = 0;  // bytes of the tracked tags that are not evicted
+  uint32_t evictions = 0;
+  uint32_t contextEvictions = 0;
+  uint32_t reloads = 0;
+  double evictedBytes = 0;
+};
+
+KeyBudgetStats &GetKeyBudgetStatsRef() {
+  static KeyBudgetStats stats;
+  return stats;
+}
+
+template<typename Element>
+std::map<std::string, TrackedKeyTag<Element>> &GetTrackedKeyTags() {
+  static std::map<std::string, TrackedKeyTag<Element>> tags;
+  return tags;
+}
+
+/**
+ * @brief Tags that are not evicted, keyed by their last use, so the least
+ * recently used one comes first.
+ */
+template<typename Element>
+std::map<uint64_t, std::string> &GetResidentKeyTagsByUse() {
+  static std::map<uint64_t, std::string> tags;
+  return tags;
+}
+
+/**
+ * @brief Last use of each context with tracked tags.
+ */
+template<typename Element>
+std::map<CryptoContext<Element>, uint64_t> &GetTrackedContexts() {
+  static std::map<CryptoContext<Element>, uint64_t> contexts;
+  return contexts;
+}
+
+/**
+ * @brief Heap bytes of the polynomials held by an evaluation key.
+ */
+template<typename Element>
+size_t GetEvalKeyBytes(const EvalKey<Element> &key) {
+  size_t bytes = 0;
+  for (const auto *polys : {&key->GetAVector(), &key->GetBVector()}) {
+    for (const auto &poly : *polys) {
+      bytes += poly.GetNumOfElements() * poly.GetRingDimension() * sizeof(NativeInteger);
+    }
+  }
+  return bytes;
+}
+
+/**
+ * @brief Heap bytes of the relinearization and rotation keys of a key tag.
+ */
+template<typename Element>
+size_t GetKeyTagBytes(const std::string &keyTag) {
+  size_t bytes = 0;
+  const auto &multKeys = CryptoContextImpl<Element>::GetAllEvalMultKeys();
+  const auto mult = multKeys.find(keyTag);
+  if (mult != multKeys.end()) {
+    for (const auto &key : mult->second) bytes += GetEvalKeyBytes(key);
+  }
+  const auto &automorphismKeys = CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys();
+  const auto automorphism = automorphismKeys.find(keyTag);
+  if (automorphism != automorphismKeys.end() && automorphism->second != nullptr) {
+    for (const auto &kv : *automorphism->second) bytes += GetEvalKeyBytes(kv.second);
+  }
+  return bytes;
+}
+
+template<typename Element>
+void EvictKeyTag(const std::string &keyTag, TrackedKeyTag<Element> &tracked) {
+  if (tracked.evicted) return;
+  CryptoContextImpl<Element>::ClearEvalMultKeys(keyTag);
+  CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(keyTag);
+  auto &stats = GetKeyBudgetStatsRef();
+  stats.evictions++;
+  stats.evictedBytes += tracked.bytes;
+  stats.residentBytes -= tracked.bytes;
+  GetResidentKeyTagsByUse<Element>().erase(tracked.lastUse);
+  tracked.bytes = 0;
+  tracked.evicted = true;
+}
+
+template<typename Element>
+void EvictContext(const CryptoContext<Element> &cc) {
+  for (auto &kv : GetTrackedKeyTags<Element>()) {
+    if (kv.second.cc != cc) continue;
+    EvictKeyTag(kv.first, kv.second);
+    // the tag is reloaded into whichever context EnsureEvalKeys() is called on
+    kv.second.cc = nullptr;
+  }
+  auto &cache = GetCryptoContextCache<Element>();
+  for (auto it = cache.begin(); it != cache.end();) {
+    it = it->second.cc == cc ? cache.erase(it) : std::next(it);
+  }
+  GetTrackedContexts<Element>().erase(cc);
+  GetKeyBudgetStatsRef().contextEvictions++;
+}
+
+/**
+ * @brief Evict least recently used tags and contexts until the budget and
+ * the context limit hold. The most recently used tag is never evicted.
+ */
+template<typename Element>
+void EnforceKeyBudget(const std::string &current) {
+  auto &tags = GetTrackedKeyTags<Element>();
+  auto &contexts = GetTrackedContexts<Element>();
+  auto &stats = GetKeyBudgetStatsRef();
+
+  const auto currentCC = tags.at(current).cc;
+  while (stats.contextLimit && contexts.size() > stats.contextLimit) {
+    auto lru = contexts.end();
+    for (auto it = contexts.begin(); it != contexts.end(); ++it) {
+      if (it->first != currentCC && (lru == contexts.end() || it->second < lru->second)) lru = it;
+    }
+    if (lru == contexts.end()) break;
+    EvictContext(CryptoContext<Element>(lru->first));
+  }
+
+  auto &byUse = GetResidentKeyTagsByUse<Element>();
+  while (stats.budget && stats.residentBytes > stats.budget) {
+    auto lru = byUse.begin();
+    if (lru != byUse.end() && lru->second == current) ++lru;
+    if (lru == byUse.end()) break;
+    const auto keyTag = lru->second;
+    EvictKeyTag(keyTag, tags.at(keyTag));
+  }
+}
+
+/**
+ * @brief Mark the keys of a tag as used and enforce the budget.
+ * Call it before serving a tenant, and after generating, deserializing or
+ * reloading the tenant's keys so they are accounted for.
+ * @param cc - context the keys belong to.
+ * @param keyTag - key tag, as returned by GetKeyTag().
+ * @return true if the tag has keys resident.
+ */
+template<typename Element>
+bool TouchEvalKeys(const CryptoContext<Element> &cc, const std::string &keyTag) {
+  auto &stats = GetKeyBudgetStatsRef();
+  auto &byUse = GetResidentKeyTagsByUse<Element>();
+  auto &tracked = GetTrackedKeyTags<Element>()[keyTag];
+  if (!tracked.evicted) byUse.erase(tracked.lastUse);
+  tracked.cc = cc;
+  tracked.lastUse = ++stats.clock;
+  GetTrackedContexts<Element>()[cc] = tracked.lastUse;
+
+  const auto bytes = GetKeyTagBytes<Element>(keyTag);
+  if (tracked.evicted && bytes > 0) {
+    tracked.evicted = false;
+    stats.reloads++;
+  }
+  if (!tracked.evicted) {
+    stats.residentBytes += static_cast<double>(bytes) - static_cast<double>(tracked.bytes);
+    tracked.bytes = bytes;
+    byUse[tracked.lastUse] = keyTag;
+  }
+
+  EnforceKeyBudget<Element>(keyTag);
+  return !tracked.evicted && tracked.bytes > 0;
+}
+
+/**
+ * @brief Whether a tracked tag was evicted and needs its keys reloaded.
+ */
+bool IsEvalKeyEvicted(const std::string &keyTag) {
+  const auto &tags = GetTrackedKeyTags<DCRTPoly>();
+  const auto it = tags.find(keyTag);
+  return it != tags.end() && it->second.evicted;
+}
+
+void EvictEvalKeys(const std::string &keyTag) {
+  auto &tags = GetTrackedKeyTags<DCRTPoly>();
+  const auto it = tags.find(keyTag);
+  if (it != tags.end()) EvictKeyTag(it->first, it->second);
+}
+
+/**
+ * @brief Evict every tracked tag of a context, and its context cache entries.
+ * The tags stay tracked as evicted, so EnsureEvalKeys() reloads them.
+ */
+void EvictCryptoContext(const CryptoContext<DCRTPoly> &cc) { EvictContext(cc); }
+
+/**
+ * @brief Stop tracking a tag without clearing its keys.
+ */
+void UntrackEvalKeys(const std::string &keyTag) {
+  auto &tags = GetTrackedKeyTags<DCRTPoly>();
+  const auto it = tags.find(keyTag);
+  if (it == tags.end()) return;
+  if (!it->second.evicted) {
+    GetKeyBudgetStatsRef().residentBytes -= it->second.bytes;
+    GetResidentKeyTagsByUse<DCRTPoly>().erase(it->second.lastUse);
+  }
+  tags.erase(it);
+}
+
+/**
+ * @brief Forget all tracked tags and reset the limits and counters.
+ * The keys themselves are left in place.
+ */
+void ClearKeyBudget() {
+  GetTrackedKeyTags<DCRTPoly>().clear();
+  GetResidentKeyTagsByUse<DCRTPoly>().clear();
+  GetTrackedContexts<DCRTPoly>().clear();
+  GetKeyBudgetStatsRef() = KeyBudgetStats();
+}
+
+void SetEvalKeyBudget(double bytes) { GetKeyBudgetStatsRef().budget = bytes; }
+
+double GetEvalKeyBudget() { return GetKeyBudgetStatsRef().budget; }
+
+void SetContextLimit(uint32_t limit) { GetKeyBudgetStatsRef().contextLimit = limit; }
+
+/**
+ * @brief Bytes of tracked keys currently resident.
+ */
+double GetResidentEvalKeyBytes() { return GetKeyBudgetStatsRef().residentBytes; }
+
+uint32_t GetResidentKeyTags() { return GetResidentKeyTagsByUse<DCRTPoly>().size(); }
+
+uint32_t GetKeyEvictions() { return GetKeyBudgetStatsRef().evictions; }
+
+uint32_t GetContextEvictions() { return GetKeyBudgetStatsRef().contextEvictions; }
+
+uint32_t GetKeyReloads() { return GetKeyBudgetStatsRef().reloads; }
+
+double GetEvictedKeyBytes() { return GetKeyBudgetStatsRef().evictedBytes; }
+
+EMSCRIPTEN_BINDINGS(key_budget) {
+  emscripten::function("TouchEvalKeys", &TouchEvalKeys<DCRTPoly>);
+  emscripten::function("IsEvalKeyEvicted", &IsEvalKeyEvicted);
+  emscripten::function("EvictEvalKeys", &EvictEvalKeys);
+  emscripten::function("EvictCryptoContext", &EvictCryptoContext);
+  emscripten::function("UntrackEvalKeys", &UntrackEvalKeys);
+  emscripten::function("ClearKeyBudget", &ClearKeyBudget);
+  emscripten::function("SetEvalKeyBudget", &SetEvalKeyBudget);
+  emscripten::function("GetEvalKeyBudget", &GetEvalKeyBudget);
+  emscripten::function("SetContextLimit", &SetContextLimit);
+  emscripten::function("GetResidentEvalKeyBytes", &GetResidentEvalKeyBytes);
+  emscripten::function("GetResidentKeyTags", &GetResidentKeyTags);
+  emscripten::function("GetKeyEvictions", &GetKeyEvictions);
+  emscripten::function("GetContextEvictions", &GetContextEvictions);
+  emscripten::function("GetKeyReloads", &GetKeyReloads);
+  emscripten::function("GetEvictedKeyBytes", &GetEvictedKeyBytes);
+}
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef _OPENFHEWEB_PKE_MULTIPARTY_EM_H
+#define _OPENFHEWEB_PKE_MULTIPARTY_EM_H
+
+#include "openfhe.h"
+using namespace lbcrypto;
+
+// Aggregation of per-party eval key shares in a single call.
+//
+// The pairwise Multi*Add* calls are associative, so the shares of N parties
+// are combined with a balanced tree reduction: N - 1 additions, a depth of
+// log2(N), and one boundary crossing instead of N - 1.
+
+template<typename T, typename Combine>
+T TreeReduce(std::vector<T> items, Combine combine) {
+  if (items.empty()) OPENFHE_THROW("no key shares to aggregate");
+  while (items.size() > 1) {
+    std::vector<T> next;
+    next.reserve((items.size() + 1) / 2);
+    for (size_t i = 0; i + 1 < items.size(); i += 2) {
+      next.push_back(combine(items[i], items[i + 1]));
+    }
+    if (items.size() % 2 == 1) next.push_back(items.back());
+    items.swap(next);
+  }
+  return items[0];
+}
+
+/**
+ * @brief Threshold FHE: add the key switching key shares of all parties.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param evalKeysJs - one EvalKey share per party.
+ * @param keyTag - tag of the joint key.
+ * @return joint key switching key.
+ */
+template<typename Element>
+EvalKey<Element> MultiAddEvalKeysBatch(const CryptoContext<Element> &cryptoCtx,
+                                       const emscripten::val &evalKeysJs,
+                                       const std::string &keyTag) {
+  return TreeReduce(vecFromJSArray<EvalKey<Element>>(evalKeysJs),
+                    [&](const EvalKey<Element> &a, const EvalKey<Element> &b) {
+                      return cryptoCtx->MultiAddEvalKeys(a, b, keyTag);
+                    });
+}
+
+/**
+ * @brief Threshold FHE: add the eval mult key shares produced by
+ * MultiMultEvalKey() of all parties.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param evalKeysJs - one EvalKey share per party.
+ * @param keyTag - tag of the joint key.
+ * @return joint eval mult key.
+ */
+template<typename Element>
+EvalKey<Element> MultiAddEvalMultKeysBatch(const CryptoContext<Element> &cryptoCtx,
+                                           const emscripten::val &evalKeysJs,
+                                           const std::string &keyTag) {
+  return TreeReduce(vecFromJSArray<EvalKey<Element>>(evalKeysJs),
+                    [&](const EvalKey<Element> &a, const EvalKey<Element> &b) {
+                      return cryptoCtx->MultiAddEvalMultKeys(a, b, keyTag);
+                    });
+}
+
+/**
+ * @brief Threshold FHE: add the eval sum key map shares of all parties.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param evalKeyMapsJs - one key map share per party.
+ * @param keyTag - tag of the joint keys.
+ * @return joint eval sum key map.
+ */
+template<typename Element>
+std::shared_ptr<std::map<usint, EvalKey<Element>>>
+MultiAddEvalSumKeysBatch(const CryptoContext<Element> &cryptoCtx,
+                         const emscripten::val &evalKeyMapsJs,
+                         const std::string &keyTag) {
+  using KeyMap = std::shared_ptr<std::map<usint, EvalKey<Element>>>;
+  return TreeReduce(vecFromJSArray<KeyMap>(evalKeyMapsJs),
+                    [&](const KeyMap &a, const KeyMap &b) {
+                      return cryptoCtx->MultiAddEvalSumKeys(a, b, keyTag);
+                    });
+}
+
+/**
+ * @brief Threshold FHE: add the rotation key map shares of all parties.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param evalKeyMapsJs - one key map share per party, from
+ * MultiEvalAtIndexKeyGen() or the lead party's GetEvalAutomorphismKeyMap().
+ * @param keyTag - tag of the joint keys.
+ * @return joint rotation key map.
+ */
+template<typename Element>
+std::shared_ptr<std::map<usint, EvalKey<Element>>>
+MultiAddEvalAutomorphismKeysBatch(const CryptoContext<Element> &cryptoCtx,
+                                  const emscripten::val &evalKeyMapsJs,
+                                  const std::string &keyTag) {
+  using KeyMap = std::shared_ptr<std::map<usint, EvalKey<Element>>>;
+  return TreeReduce(vecFromJSArray<KeyMap>(evalKeyMapsJs),
+                    [&](const KeyMap &a, const KeyMap &b) {
+                      return cryptoCtx->MultiAddEvalAutomorphismKeys(a, b, keyTag);
+                    });
+}
+
+/**
+ * @brief Threshold FHE: rotation key shares of a party for a list of indices,
+ * derived from the lead party's rotation keys.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param privateKey - secret key share of the current party.
+ * @param evalKeyMap - rotation keys of the lead party.
+ * @param indexList - list of indices.
+ * @param keyTag - tag of the joint keys.
+ * @return the party's rotation key map share.
+ */
+template<typename Element>
+std::shared_ptr<std::map<usint, EvalKey<Element>>>
+MultiEvalAtIndexKeyGen(const CryptoContext<Element> &cryptoCtx,
+                       const PrivateKey<Element> privateKey,
+                       const std::shared_ptr<std::map<usint, EvalKey<Element>>> evalKeyMap,
+                       const emscripten::val &indexList,
+                       const std::string &keyTag) {
+  return cryptoCtx->MultiEvalAtIndexKeyGen(privateKey, evalKeyMap, vecFromJSArray<int32_t>(indexList), keyTag);
+}
+
+/**
+ * @brief Get the rotation key map generated for a key tag.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param keyTag - key tag.
+ * @return copy of the rotation key map.
+ */
+template<typename Element>
+std::shared_ptr<std::map<usint, EvalKey<Element>>>
+GetEvalAutomorphismKeyMap(const CryptoContext<Element> &cryptoCtx, const std::string &keyTag) {
+  return std::make_shared<std::map<usint, EvalKey<Element>>>(cryptoCtx->GetEvalAutomorphismKeyMap(keyTag));
+}
+
+/**
+ * @brief Install a joint rotation key map so EvalAtIndex() can use it.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param mapToInsert - rotation key map.
+ * @param keyTag - key tag the map is stored under.
+ */
+template<typename Element>
+void InsertEvalAutomorphismKey(const CryptoContext<Element> &cryptoCtx,
+                               const std::shared_ptr<std::map<usint, EvalKey<Element>>> mapToInsert,
+                               const std::string &keyTag) {
+  cryptoCtx->InsertEvalAutomorphismKey(mapToInsert, keyTag);
+}
+
+#endif
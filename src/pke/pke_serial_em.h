@@ -2,20 +2,20 @@
 #define _OPENFHEWEB_PKE_SERIAL_EM_H
 
 #include "core/serial_em.h"
+#include "core/trace_em.h"
 #include "globals.h"
 using namespace lbcrypto;
 
 /**
- * @brief Deserialize into the CryptoContext from JsBuffer.
- * @param jsBuf - input object as a buffer.
+ * @brief Parse a serialized CryptoContext without registering it.
+ * @param stream - serialized CryptoContext.
  * @param serType - #BINARY or #JSON
  * @return nullptr - in case of exception.
- * @return CryptoContext.
+ * @return CryptoContext, not yet known to the CryptoContextFactory.
  */
 template<typename Element>
-CryptoContext<Element> DeserializeCryptoContextFromBuffer(const emscripten::val &jsBuf, JsSerType serType) {
+CryptoContext<Element> ParseCryptoContextFromStream(std::istream &stream, JsSerType serType) {
   CryptoContext<Element> cc;
-  auto stream = typedArrayToStringstream(jsBuf);
 
   try {
     if (serType == JsSerType::BINARY) {
@@ -29,6 +29,21 @@ CryptoContext<Element> DeserializeCryptoContextFromBuffer(const emscripten::val
     std::cerr << e.what() << std::endl;
     return nullptr;
   }
+  return cc;
+}
+
+/**
+ * @brief Deserialize a CryptoContext from a stream and register it with the
+ * CryptoContextFactory.
+ * @param stream - serialized CryptoContext.
+ * @param serType - #BINARY or #JSON
+ * @return nullptr - in case of exception.
+ * @return CryptoContext.
+ */
+template<typename Element>
+CryptoContext<Element> DeserializeCryptoContextFromStream(std::istream &stream, JsSerType serType) {
+  auto cc = ParseCryptoContextFromStream<Element>(stream, serType);
+  if (cc == nullptr) return nullptr;
 
   auto getCC = CryptoContextFactory<Element>::GetContext(cc->GetCryptoParameters(), cc->GetScheme(),
                                                          cc->getSchemeId());
@@ -36,20 +51,46 @@ CryptoContext<Element> DeserializeCryptoContextFromBuffer(const emscripten::val
   return getCC;
 }
 
+/**
+ * @brief Deserialize into the CryptoContext from JsBuffer.
+ * @param jsBuf - input object as a buffer.
+ * @param serType - #BINARY or #JSON
+ * @return nullptr - in case of exception.
+ * @return CryptoContext.
+ */
+template<typename Element>
+CryptoContext<Element> DeserializeCryptoContextFromBuffer(const emscripten::val &jsBuf, JsSerType serType) {
+  auto stream = typedArrayToStringstream(jsBuf);
+  return DeserializeCryptoContextFromStream<Element>(stream, serType);
+}
+
+// slim client modules (src/pke/client_em.cpp) bind their own subset
+#ifndef OPENFHEWEB_SLIM_CLIENT
 EMSCRIPTEN_BINDINGS(serial) {
-  emscripten::function("SerializeCryptoContextToBuffer", &SerializeToBuffer<CryptoContext<DCRTPoly>>,
+  emscripten::function("SerializeCryptoContextToBuffer",
+                       Traced<&SerializeToBuffer<CryptoContext<DCRTPoly>>>("SerializeCryptoContextToBuffer"),
                        allow_raw_pointers());
-  emscripten::function("SerializePublicKeyToBuffer", &SerializeToBuffer<PublicKey<DCRTPoly>>, allow_raw_pointers());
-  emscripten::function("SerializePrivateKeyToBuffer", &SerializeToBuffer<PrivateKey<DCRTPoly>>, allow_raw_pointers());
-  emscripten::function("SerializeCiphertextToBuffer", &SerializeToBuffer<Ciphertext<DCRTPoly>>);
-  emscripten::function("DeserializeCryptoContextFromBuffer", &DeserializeCryptoContextFromBuffer<DCRTPoly>,
+  emscripten::function("SerializePublicKeyToBuffer",
+                       Traced<&SerializeToBuffer<PublicKey<DCRTPoly>>>("SerializePublicKeyToBuffer"),
                        allow_raw_pointers());
-  emscripten::function("DeserializePublicKeyFromBuffer", &DeserializeFromBuffer<PublicKey<DCRTPoly>>);
-  emscripten::function("DeserializePrivateKeyFromBuffer", &DeserializeFromBuffer<PrivateKey<DCRTPoly>>);
-  emscripten::function("DeserializeCiphertextFromBuffer", &DeserializeFromBuffer<Ciphertext<DCRTPoly>>);
+  emscripten::function("SerializePrivateKeyToBuffer",
+                       Traced<&SerializeToBuffer<PrivateKey<DCRTPoly>>>("SerializePrivateKeyToBuffer"),
+                       allow_raw_pointers());
+  emscripten::function("SerializeCiphertextToBuffer",
+                       Traced<&SerializeToBuffer<Ciphertext<DCRTPoly>>>("SerializeCiphertextToBuffer"));
+  emscripten::function("DeserializeCryptoContextFromBuffer",
+                       Traced<&DeserializeCryptoContextFromBuffer<DCRTPoly>>("DeserializeCryptoContextFromBuffer"),
+                       allow_raw_pointers());
+  emscripten::function("DeserializePublicKeyFromBuffer",
+                       Traced<&DeserializeFromBuffer<PublicKey<DCRTPoly>>>("DeserializePublicKeyFromBuffer"));
+  emscripten::function("DeserializePrivateKeyFromBuffer",
+                       Traced<&DeserializeFromBuffer<PrivateKey<DCRTPoly>>>("DeserializePrivateKeyFromBuffer"));
+  emscripten::function("DeserializeCiphertextFromBuffer",
+                       Traced<&DeserializeFromBuffer<Ciphertext<DCRTPoly>>>("DeserializeCiphertextFromBuffer"));
   emscripten::function("PrecomputeCRTTablesAfterDeserializaton", &PrecomputeCRTTablesAfterDeserializaton);
   emscripten::function("EnablePrecomputeCRTTablesAfterDeserializaton", &EnablePrecomputeCRTTablesAfterDeserializaton);
   emscripten::function("DisablePrecomputeCRTTablesAfterDeserializaton", &DisablePrecomputeCRTTablesAfterDeserializaton);
 }
+#endif
 
 #endif
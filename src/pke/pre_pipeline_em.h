@@ -0,0 +1,168 @@
+#ifndef _OPENFHEWEB_PKE_PRE_PIPELINE_EM_H
+#define _OPENFHEWEB_PKE_PRE_PIPELINE_EM_H
+
+#include "byte_packing.h"
+#include "core/serial_em.h"
+#include "core/trace_em.h"
+using namespace lbcrypto;
+
+// Streaming proxy re-encryption of byte payloads.
+//
+// Bytes are packed densely into the slots of BFV/BGV plaintexts (see
+// byte_packing.h), encrypted under the sender's public key, re-encrypted with
+// the re-encryption key and serialized one ciphertext at a time. Each record
+// of the output stream is
+//
+//   uint32   payload bytes carried by the ciphertext
+//   uint32   serialized ciphertext length
+//   bytes    binary serialization of the re-encrypted ciphertext
+//
+// Push() consumes a chunk of any size and returns the records for every full
+// ciphertext it completes; at most one ciphertext worth of input is kept
+// between calls, so memory stays bounded by the chunk size.
+
+/**
+ * @brief Number of slots available in a packed plaintext of the context.
+ */
+template<typename Element>
+uint32_t GetPackedSlots(const CryptoContext<Element> &cryptoCtx) {
+  const auto batchSize = cryptoCtx->GetEncodingParams()->GetBatchSize();
+  return batchSize > 0 ? batchSize : cryptoCtx->GetRingDimension();
+}
+
+template<typename Element>
+class BytePREPipeline {
+ public:
+  BytePREPipeline(CryptoContext<Element> cryptoCtx, PublicKey<Element> publicKey, EvalKey<Element> reEncryptionKey)
+      : m_cryptoCtx(cryptoCtx), m_publicKey(publicKey), m_reEncryptionKey(reEncryptionKey) {
+    m_bitsPerSlot = BitsPerSlot(cryptoCtx->GetEncodingParams()->GetPlaintextModulus());
+    m_bytesPerCiphertext = BytesForSlots(GetPackedSlots(cryptoCtx), m_bitsPerSlot);
+    m_pending.reserve(m_bytesPerCiphertext);
+  }
+
+  /**
+   * @brief Feed a chunk of the payload.
+   * @param chunk - Uint8Array.
+   * @return records for the ciphertexts completed by this chunk.
+   */
+  emscripten::val Push(const emscripten::val &chunk) {
+    const auto bytes = typedArrayToString(chunk);
+    std::ostringstream records;
+    size_t offset = 0;
+    while (offset < bytes.size()) {
+      const auto take = std::min(bytes.size() - offset, m_bytesPerCiphertext - m_pending.size());
+      m_pending.append(bytes, offset, take);
+      offset += take;
+      if (m_pending.size() == m_bytesPerCiphertext) EmitPending(records);
+    }
+    return stringstreamToTypedArray(records);
+  }
+
+  /**
+   * @brief Flush the last, partially filled ciphertext.
+   * @return the remaining record, or an empty Uint8Array.
+   */
+  emscripten::val Finish() {
+    std::ostringstream records;
+    if (!m_pending.empty()) EmitPending(records);
+    return stringstreamToTypedArray(records);
+  }
+
+  uint32_t GetBytesPerCiphertext() const { return m_bytesPerCiphertext; }
+  double GetBytesProcessed() const { return m_bytesProcessed; }
+
+ private:
+  void EmitPending(std::ostream &records) {
+    const auto slots = PackBytes(reinterpret_cast<const uint8_t *>(m_pending.data()), m_pending.size(),
+                                 m_cryptoCtx->GetEncodingParams()->GetPlaintextModulus(), m_bitsPerSlot);
+    Ciphertext<Element> reEncrypted;
+    {
+      TraceSpan span("Encrypt", "openfhe");
+      reEncrypted = m_cryptoCtx->Encrypt(m_publicKey, m_cryptoCtx->MakePackedPlaintext(slots));
+    }
+    {
+      TraceSpan span("ReEncrypt", "openfhe");
+      reEncrypted = m_cryptoCtx->ReEncrypt(reEncrypted, m_reEncryptionKey);
+    }
+
+    std::ostringstream serialized;
+    {
+      TraceSpan span("Serialize", "openfhe");
+      Serial::Serialize(reEncrypted, serialized, SerType::BINARY);
+    }
+    const auto serializedStr = serialized.str();
+
+    WriteRaw<uint32_t>(records, m_pending.size());
+    WriteRaw<uint32_t>(records, serializedStr.size());
+    records.write(serializedStr.data(), serializedStr.size());
+
+    m_bytesProcessed += m_pending.size();
+    m_pending.clear();
+  }
+
+  CryptoContext<Element> m_cryptoCtx;
+  PublicKey<Element> m_publicKey;
+  EvalKey<Element> m_reEncryptionKey;
+  uint32_t m_bitsPerSlot;
+  size_t m_bytesPerCiphertext;
+  std::string m_pending;
+  double m_bytesProcessed = 0;
+};
+
+/**
+ * @brief Decrypt a record stream written by BytePREPipeline back into bytes.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param secretKey - secret key of the recipient.
+ * @param recordsJs - records as a Uint8Array.
+ * @return the payload as a Uint8Array.
+ */
+template<typename Element>
+emscripten::val DecryptByteRecords(const CryptoContext<Element> &cryptoCtx,
+                                   const PrivateKey<Element> secretKey,
+                                   const emscripten::val &recordsJs) {
+  const auto plaintextModulus = cryptoCtx->GetEncodingParams()->GetPlaintextModulus();
+  const auto bitsPerSlot = BitsPerSlot(plaintextModulus);
+  auto stream = typedArrayToStringstream(recordsJs);
+
+  std::string payload;
+  while (stream.peek() != std::char_traits<char>::eof()) {
+    const auto numBytes = ReadRaw<uint32_t>(stream);
+    const auto serializedLength = ReadRaw<uint32_t>(stream);
+    std::string serialized(serializedLength, '\0');
+    if (!stream.read(&serialized[0], serializedLength)) OPENFHE_THROW("unexpected end of buffer");
+
+    Ciphertext<Element> ciphertext;
+    std::istringstream serializedStream(serialized);
+    Serial::Deserialize(ciphertext, serializedStream, SerType::BINARY);
+
+    Plaintext plaintext;
+    cryptoCtx->Decrypt(secretKey, ciphertext, &plaintext);
+    const auto offset = payload.size();
+    payload.resize(offset + numBytes);
+    UnpackBytes(plaintext->GetPackedValue(), plaintextModulus, bitsPerSlot,
+                reinterpret_cast<uint8_t *>(&payload[offset]), numBytes);
+  }
+
+  std::ostringstream outputBuffer;
+  outputBuffer.write(payload.data(), payload.size());
+  return stringstreamToTypedArray(outputBuffer);
+}
+
+template<typename Element>
+std::shared_ptr<BytePREPipeline<Element>> MakeBytePREPipeline(CryptoContext<Element> cryptoCtx,
+                                                              PublicKey<Element> publicKey,
+                                                              EvalKey<Element> reEncryptionKey) {
+  return std::make_shared<BytePREPipeline<Element>>(cryptoCtx, publicKey, reEncryptionKey);
+}
+
+EMSCRIPTEN_BINDINGS(pre_pipeline) {
+  class_<BytePREPipeline<DCRTPoly>>("BytePREPipeline")
+      .smart_ptr<std::shared_ptr<BytePREPipeline<DCRTPoly>>>("BytePREPipeline")
+      .constructor(Traced<&MakeBytePREPipeline<DCRTPoly>>("BytePREPipeline"))
+      .function("Push", Traced<&BytePREPipeline<DCRTPoly>::Push>("BytePREPipeline.Push"))
+      .function("Finish", Traced<&BytePREPipeline<DCRTPoly>::Finish>("BytePREPipeline.Finish"))
+      .function("GetBytesPerCiphertext", &BytePREPipeline<DCRTPoly>::GetBytesPerCiphertext)
+      .function("GetBytesProcessed", &BytePREPipeline<DCRTPoly>::GetBytesProcessed);
+}
+
+#endif
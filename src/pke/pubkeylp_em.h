@@ -1,6 +1,7 @@
 #ifndef _OPENFHEWEB_PKE_PUBKEYLP_EM_H
 #define _OPENFHEWEB_PKE_PUBKEYLP_EM_H
 
+#include "core/openfhe_em.h"
 #include "core/wrapped.h"
 #include "openfhe.h"
 
@@ -11,11 +12,26 @@ std::string GetEncodingType(const CiphertextImpl<Element> &ciphertext) {
   return ss.str();
 }
 
+/**
+ * @brief Deep copy of a ciphertext. Unlike the clone() of the JS handle,
+ * the copy does not share its elements with the original.
+ */
 template<typename Element>
-uint32_t GetWrappedPlaintextModulusParametersBase(
+Ciphertext<Element> CloneCiphertext(const CiphertextImpl<Element> &ciphertext) {
+  return ciphertext.Clone();
+}
+
+template<typename Element>
+double GetWrappedPlaintextModulusParametersBase(
+    const CryptoParametersBase<Element> &lpCryptoParameters) {
+  // exact for plaintext moduli up to 2^53
+  return static_cast<double>(lpCryptoParameters.GetPlaintextModulus());
+}
+
+template<typename Element>
+emscripten::val GetPlaintextModulusBigIntParametersBase(
     const CryptoParametersBase<Element> &lpCryptoParameters) {
-  // assume that the plaintext modulus is < 2^31
-  return (uint32_t ) lpCryptoParameters.GetPlaintextModulus();
+  return Uint64ToBigInt(lpCryptoParameters.GetPlaintextModulus());
 }
 EMSCRIPTEN_BINDINGS(pke_publey) {
   class_<CryptoObject<DCRTPoly >>("CryptoObject_DCRTPoly")
@@ -32,17 +48,20 @@ EMSCRIPTEN_BINDINGS(pke_publey) {
       .smart_ptr<Ciphertext<DCRTPoly>>("Ciphertext_DCRTPoly")
       .smart_ptr<ConstCiphertext<DCRTPoly>>("ConstCiphertext_DCRTPoly")
       .function("GetEncodingType", &GetEncodingType<DCRTPoly>)
+      .function("Clone", &CloneCiphertext<DCRTPoly>)
       .function("toString", &GetString<CiphertextImpl<DCRTPoly>>);
 
   class_<CryptoParametersBase<DCRTPoly>>("CryptoParameters_DCRTPoly")
       .smart_ptr < std::shared_ptr < CryptoParametersBase<DCRTPoly>>>("CryptoParameters_DCRTPoly")
       .function("GetElementParams", &CryptoParametersBase<DCRTPoly>::GetElementParams)
       .function("GetPlaintextModulus", &GetWrappedPlaintextModulusParametersBase<DCRTPoly>)
+      .function("GetPlaintextModulusBigInt", &GetPlaintextModulusBigIntParametersBase<DCRTPoly>)
       .function("GetDigitSize", &CryptoParametersBase<DCRTPoly>::GetDigitSize)
       .function("toString", &GetString<CryptoParametersBase< DCRTPoly>>);
 
 
   class_<KeyPair<DCRTPoly>>("KeyPair_DCRTPoly")
+      .constructor<PublicKey<DCRTPoly>, PrivateKey<DCRTPoly>>()
       .function("good", &KeyPair<DCRTPoly>::good)
       .property("secretKey", &KeyPair<DCRTPoly>::secretKey)
       .property("publicKey", &KeyPair<DCRTPoly>::publicKey);
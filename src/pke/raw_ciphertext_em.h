@@ -0,0 +1,192 @@
+#ifndef _OPENFHEWEB_PKE_RAW_CIPHERTEXT_EM_H
+#define _OPENFHEWEB_PKE_RAW_CIPHERTEXT_EM_H
+
+#include "element_codec.h"
+#include "context_cache_em.h"
+#include "core/trace_em.h"
+using namespace lbcrypto;
+
+// Same-context ciphertext codec for workers that hold the same CryptoContext.
+//
+// The tower coefficients are copied as they are laid out in memory, one copy
+// per tower in each direction, instead of going through cereal field by
+// field. The format is only readable by a build with the same native word
+// size and byte order, and only with a context of the same moduli chain,
+// which the header records as a fingerprint:
+//
+//   char[8]  magic "OFHERAWC"
+//   uint32   header length (bytes up to the tower data)
+//   uint32   NATIVEINT of the writer
+//   uint32   ring dimension
+//   uint64   fingerprint of the context's moduli chain
+//   ciphertext metadata (see WriteCiphertextMetadata)
+//   uint32   key tag length, key tag
+//   uint32   number of elements
+//   per element: uint8 format, uint32 number of towers
+//   tower data: per element, per tower, ring dimension native words
+const char kRawCiphertextMagic[8] = {'O', 'F', 'H', 'E', 'R', 'A', 'W', 'C'};
+
+static_assert(sizeof(NativeInteger) == sizeof(BasicInteger), "NativeInteger is not a plain machine word");
+
+/**
+ * @brief FNV-1a hash of the ring dimension and the moduli of a context.
+ */
+template<typename Element>
+uint64_t GetModuliFingerprint(const CryptoContext<Element> &cryptoCtx) {
+  uint64_t hash = 14695981039346656037ULL;
+  const auto mix = [&hash](uint64_t value) {
+    for (int i = 0; i < 8; i++, value >>= 8) {
+      hash = (hash ^ (value & 0xff)) * 1099511628211ULL;
+    }
+  };
+  mix(cryptoCtx->GetRingDimension());
+  for (const auto &tower : cryptoCtx->GetElementParams()->GetParams()) {
+    mix(tower->GetModulus().ConvertToInt());
+  }
+  return hash;
+}
+
+/**
+ * @brief Identifier of the parameters of a context, i.e. the scheme, the
+ * plaintext modulus and the moduli chain, for matching stored ciphertexts
+ * against the context they need.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @return 16 hex digits.
+ */
+template<typename Element>
+std::string GetContextId(const CryptoContext<Element> &cryptoCtx) {
+  std::ostringstream parts;
+  WriteRaw<uint64_t>(parts, GetModuliFingerprint(cryptoCtx));
+  WriteRaw<uint32_t>(parts, static_cast<uint32_t>(cryptoCtx->getSchemeId()));
+  WriteRaw<uint64_t>(parts, cryptoCtx->GetCryptoParameters()->GetPlaintextModulus());
+  char id[17];
+  snprintf(id, sizeof(id), "%016llx", static_cast<unsigned long long>(HashBytes(parts.str())));
+  return id;
+}
+
+/**
+ * @brief Serialize a ciphertext for a worker holding the same context.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertext - ciphertext to serialize.
+ * @return Uint8Array in the raw format.
+ */
+template<typename Element>
+emscripten::val SerializeCiphertextToRawBuffer(const CryptoContext<Element> &cryptoCtx,
+                                               const Ciphertext<Element> &ciphertext) {
+  const auto &elements = ciphertext->GetElements();
+  const auto ringDim = cryptoCtx->GetRingDimension();
+
+  std::ostringstream header;
+  WriteRaw<uint32_t>(header, NATIVEINT);
+  WriteRaw<uint32_t>(header, ringDim);
+  WriteRaw<uint64_t>(header, GetModuliFingerprint(cryptoCtx));
+  WriteCiphertextMetadata(header, *ciphertext);
+  const auto &keyTag = ciphertext->GetKeyTag();
+  WriteRaw<uint32_t>(header, keyTag.size());
+  header.write(keyTag.data(), keyTag.size());
+  WriteRaw<uint32_t>(header, elements.size());
+  size_t numTowers = 0;
+  for (const auto &element : elements) {
+    WriteRaw<uint8_t>(header, static_cast<uint8_t>(element.GetFormat()));
+    WriteRaw<uint32_t>(header, element.GetNumOfElements());
+    numTowers += element.GetNumOfElements();
+  }
+  const auto headerStr = header.str();
+
+  const size_t towerBytes = static_cast<size_t>(ringDim) * sizeof(NativeInteger);
+  const size_t prefixBytes = sizeof(kRawCiphertextMagic) + sizeof(uint32_t);
+  auto result = val::global("Uint8Array").new_(prefixBytes + headerStr.size() + numTowers * towerBytes);
+
+  std::string prefix(kRawCiphertextMagic, sizeof(kRawCiphertextMagic));
+  const uint32_t headerLength = headerStr.size();
+  prefix.append(reinterpret_cast<const char *>(&headerLength), sizeof(headerLength));
+  const auto bytes = [](const std::string &str) {
+    return emscripten::typed_memory_view(str.size(), reinterpret_cast<const uint8_t *>(str.data()));
+  };
+  result.call<void>("set", bytes(prefix));
+  result.call<void>("set", bytes(headerStr), prefixBytes);
+
+  size_t offset = prefixBytes + headerStr.size();
+  for (const auto &element : elements) {
+    for (const auto &tower : element.GetAllElements()) {
+      const auto &values = tower.GetValues();
+      if (values.GetLength() != ringDim) OPENFHE_THROW("ciphertext ring dimension differs from the context");
+      const auto data = reinterpret_cast<const uint8_t *>(&values[0]);
+      result.call<void>("set", emscripten::typed_memory_view(towerBytes, data), offset);
+      offset += towerBytes;
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Deserialize a ciphertext written by SerializeCiphertextToRawBuffer()
+ * with the same context.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param jsBuf - Uint8Array in the raw format.
+ * @return the ciphertext.
+ */
+template<typename Element>
+Ciphertext<Element> DeserializeCiphertextFromRawBuffer(const CryptoContext<Element> &cryptoCtx,
+                                                       const emscripten::val &jsBuf) {
+  const auto length = jsBuf["length"].as<size_t>();
+  const size_t prefixBytes = sizeof(kRawCiphertextMagic) + sizeof(uint32_t);
+  if (length < prefixBytes) OPENFHE_THROW("not a raw ciphertext");
+  auto prefixStream = typedArrayToStringstream(jsBuf.call<emscripten::val>("subarray", 0, prefixBytes));
+  char magic[sizeof(kRawCiphertextMagic)];
+  prefixStream.read(magic, sizeof(magic));
+  if (!std::equal(magic, magic + sizeof(magic), kRawCiphertextMagic)) OPENFHE_THROW("not a raw ciphertext");
+  const size_t headerLength = ReadRaw<uint32_t>(prefixStream);
+  if (length < prefixBytes + headerLength) OPENFHE_THROW("unexpected end of buffer");
+
+  auto header =
+      typedArrayToStringstream(jsBuf.call<emscripten::val>("subarray", prefixBytes, prefixBytes + headerLength));
+  if (ReadRaw<uint32_t>(header) != NATIVEINT) {
+    OPENFHE_THROW("raw ciphertext was written by a different native backend");
+  }
+  const auto ringDim = ReadRaw<uint32_t>(header);
+  if (ringDim != cryptoCtx->GetRingDimension() || ReadRaw<uint64_t>(header) != GetModuliFingerprint(cryptoCtx)) {
+    OPENFHE_THROW("raw ciphertext was written with a different context");
+  }
+
+  auto ciphertext = std::make_shared<CiphertextImpl<Element>>(cryptoCtx);
+  ReadCiphertextMetadata(header, *ciphertext);
+  std::string keyTag(ReadRaw<uint32_t>(header), '\0');
+  if (!header.read(&keyTag[0], keyTag.size())) OPENFHE_THROW("unexpected end of buffer");
+  ciphertext->SetKeyTag(keyTag);
+
+  const auto numElements = ReadRaw<uint32_t>(header);
+  const size_t towerBytes = static_cast<size_t>(ringDim) * sizeof(NativeInteger);
+  size_t offset = prefixBytes + headerLength;
+  std::vector<Element> elements;
+  elements.reserve(numElements);
+  for (uint32_t e = 0; e < numElements; e++) {
+    const auto format = static_cast<Format>(ReadRaw<uint8_t>(header));
+    const auto numTowers = ReadRaw<uint32_t>(header);
+    if (length < offset + numTowers * towerBytes) OPENFHE_THROW("unexpected end of buffer");
+
+    // towers are left unallocated and adopt the vectors filled below
+    Element element(GetElementParamsPrefix(cryptoCtx, numTowers), format, false);
+    auto &towers = element.GetAllElements();
+    for (uint32_t i = 0; i < numTowers; i++) {
+      NativeVector values(ringDim, towers[i].GetModulus());
+      val memoryView(emscripten::typed_memory_view(towerBytes, reinterpret_cast<uint8_t *>(&values[0])));
+      memoryView.call<void>("set", jsBuf.call<emscripten::val>("subarray", offset, offset + towerBytes));
+      towers[i].SetValues(std::move(values), format);
+      offset += towerBytes;
+    }
+    elements.push_back(std::move(element));
+  }
+  ciphertext->SetElements(std::move(elements));
+  return ciphertext;
+}
+
+EMSCRIPTEN_BINDINGS(raw_ciphertext) {
+  emscripten::function("GetContextId", &GetContextId<DCRTPoly>);
+  emscripten::function("SerializeCiphertextToRawBuffer",
+                       Traced<&SerializeCiphertextToRawBuffer<DCRTPoly>>("SerializeCiphertextToRawBuffer"));
+  emscripten::function("DeserializeCiphertextFromRawBuffer",
+                       Traced<&DeserializeCiphertextFromRawBuffer<DCRTPoly>>("DeserializeCiphertextFromRawBuffer"));
+}
+
+#endif
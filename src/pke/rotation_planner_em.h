@@ -0,0 +1,329 @@
+#ifndef _OPENFHEWEB_PKE_ROTATION_PLANNER_EM_H
+#define _OPENFHEWEB_PKE_ROTATION_PLANNER_EM_H
+
+#include <algorithm>
+#include <deque>
+#include <map>
+
+#include "openfhe.h"
+#include "core/trace_em.h"
+using namespace lbcrypto;
+
+// Rotation key planner.
+//
+// Rotating by a and then by b is a rotation by a + b modulo the number of
+// slots (ringDim / 2), so a small generating set of rotation keys can serve
+// any rotation at the cost of extra key switches. The planner picks the
+// generating set for a workload under a key budget and records, for every
+// rotation amount, the shortest sequence of generators composing it.
+//
+// Once the plan's keys are generated with EvalAtIndexKeyGenPlanned(), the plan
+// is registered under the secret key's tag and EvalAtIndex() composes
+// rotations that have no key of their own.
+class RotationPlan {
+ public:
+  RotationPlan(uint32_t slots, std::vector<int32_t> keyIndices)
+      : m_slots(slots), m_keyIndices(std::move(keyIndices)), m_parent(slots, -1), m_steps(slots, 0) {
+    // breadth-first search over Z_slots with the key indices as generators
+    std::deque<uint32_t> queue = {0};
+    m_parent[0] = 0;
+    while (!queue.empty()) {
+      const auto current = queue.front();
+      queue.pop_front();
+      for (auto key : m_keyIndices) {
+        const auto next = (current + key) % m_slots;
+        if (m_parent[next] == -1) {
+          m_parent[next] = key;
+          m_steps[next] = m_steps[current] + 1;
+          queue.push_back(next);
+        }
+      }
+    }
+  }
+
+  uint32_t Normalize(int32_t index) const {
+    const int64_t r = static_cast<int64_t>(index) % m_slots;
+    return static_cast<uint32_t>(r < 0 ? r + m_slots : r);
+  }
+
+  bool CanRotate(int32_t index) const { return m_parent[Normalize(index)] != -1; }
+
+  /**
+   * @brief Number of key switches EvalAtIndex() spends on a rotation.
+   * @param index - rotation amount.
+   * @return key switches, or -1 when the generating set cannot reach it.
+   */
+  int32_t GetKeySwitches(int32_t index) const {
+    const auto r = Normalize(index);
+    return m_parent[r] == -1 ? -1 : m_steps[r];
+  }
+
+  /**
+   * @brief Generators composing a rotation, in application order.
+   * @param index - rotation amount.
+   * @return the rotation amounts to apply one after another.
+   */
+  std::vector<int32_t> Decompose(int32_t index) const {
+    std::vector<int32_t> steps;
+    auto r = Normalize(index);
+    if (m_parent[r] == -1) OPENFHE_THROW("rotation plan cannot reach index " + std::to_string(index));
+    while (r != 0) {
+      steps.push_back(m_parent[r]);
+      r = (r + m_slots - m_parent[r]) % m_slots;
+    }
+    std::reverse(steps.begin(), steps.end());
+    return steps;
+  }
+
+  /**
+   * @brief Total key switches of a workload, weighting each rotation by how
+   * often it occurs.
+   * @param frequency - occurrences of each normalized rotation amount.
+   * @return key switches, or UINT64_MAX when a rotation is unreachable.
+   */
+  uint64_t GetWorkloadKeySwitches(const std::map<int32_t, uint32_t> &frequency) const {
+    uint64_t total = 0;
+    for (const auto &kv : frequency) {
+      const auto r = Normalize(kv.first);
+      if (m_parent[r] == -1) return UINT64_MAX;
+      total += static_cast<uint64_t>(m_steps[r]) * kv.second;
+    }
+    return total;
+  }
+
+  /**
+   * @brief Record the trade-off report for the workload the plan was built for.
+   * Rotations by 0 and rotations the plan cannot reach are left out.
+   */
+  void SetWorkload(const std::map<int32_t, uint32_t> &frequency) {
+    m_extraKeySwitches = 0;
+    m_maxKeySwitches = 0;
+    for (const auto &kv : frequency) {
+      const auto r = Normalize(kv.first);
+      if (r == 0 || m_parent[r] == -1) continue;
+      const auto switches = m_steps[r];
+      m_extraKeySwitches += (switches - 1) * kv.second;
+      m_maxKeySwitches = std::max(m_maxKeySwitches, switches);
+    }
+  }
+
+  const std::vector<int32_t> &GetKeyIndices() const { return m_keyIndices; }
+  uint32_t GetNumKeys() const { return m_keyIndices.size(); }
+  uint32_t GetSlots() const { return m_slots; }
+  uint32_t GetExtraKeySwitches() const { return m_extraKeySwitches; }
+  uint32_t GetMaxKeySwitches() const { return m_maxKeySwitches; }
+
+ private:
+  uint32_t m_slots;
+  std::vector<int32_t> m_keyIndices;
+  std::vector<int32_t> m_parent;
+  std::vector<uint32_t> m_steps;
+  uint32_t m_extraKeySwitches = 0;
+  uint32_t m_maxKeySwitches = 0;
+};
+
+/**
+ * @brief Key switches of a rotation once a key joins the generating set.
+ * Rotations commute, so a shortest composition can apply the new key last,
+ * j times after a composition of the old keys, for the cheapest j.
+ * @param steps - key switches of every rotation with the old keys.
+ * @param index - normalized rotation amount.
+ * @param key - normalized rotation amount of the new key.
+ * @return key switches of the rotation with the new key.
+ */
+inline uint32_t GetKeySwitchesWithKey(const std::vector<uint32_t> &steps, uint32_t index, uint32_t key) {
+  const uint32_t slots = steps.size();
+  auto best = steps[index];
+  auto r = index;
+  for (uint32_t j = 1; j < best; j++) {
+    r = (r + slots - key) % slots;
+    best = std::min(best, steps[r] + j);
+  }
+  return best;
+}
+
+std::map<std::string, std::shared_ptr<RotationPlan>> &GetRotationPlans() {
+  static std::map<std::string, std::shared_ptr<RotationPlan>> plans;
+  return plans;
+}
+
+/**
+ * @brief Rotation plan registered for a key tag.
+ * @param keyTag - tag of the secret key the rotation keys belong to.
+ * @return the plan, or nullptr when rotations for this tag are not planned.
+ */
+std::shared_ptr<RotationPlan> FindRotationPlan(const std::string &keyTag) {
+  const auto &plans = GetRotationPlans();
+  const auto it = plans.find(keyTag);
+  return it == plans.end() ? nullptr : it->second;
+}
+
+/**
+ * @brief Pick a generating set of rotation keys for a workload.
+ *
+ * Indices listed several times in the workload are treated as hot. When the
+ * distinct indices fit into the budget they are all given a key. Otherwise
+ * the plan starts from the powers of two, which reach every rotation, and
+ * their negatives when the budget allows, so that left and right rotations
+ * cost the same. The rest of the budget goes, one key at a time, to the
+ * candidate that saves the most key switches over the workload, weighted by
+ * how often each rotation occurs.
+ *
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param indexList - rotation indices used by the workload.
+ * @param maxKeys - maximum number of rotation keys to generate.
+ * @return the rotation plan.
+ */
+template<typename Element>
+std::shared_ptr<RotationPlan> PlanRotationKeys(const CryptoContext<Element> &cryptoCtx,
+                                               const emscripten::val &indexList,
+                                               uint32_t maxKeys) {
+  const uint32_t slots = cryptoCtx->GetRingDimension() / 2;
+  const auto normalize = [slots](int64_t index) {
+    const int64_t r = index % slots;
+    return static_cast<int32_t>(r < 0 ? r + slots : r);
+  };
+
+  std::map<int32_t, uint32_t> frequency;
+  for (auto index : vecFromJSArray<int32_t>(indexList)) {
+    const auto r = normalize(index);
+    if (r != 0) frequency[r]++;
+  }
+
+  std::vector<int32_t> keyIndices;
+  if (frequency.size() <= maxKeys) {
+    for (const auto &kv : frequency) keyIndices.push_back(kv.first);
+  } else {
+    std::vector<int32_t> positive, negative;
+    for (uint32_t p = 1; p < slots; p <<= 1) {
+      positive.push_back(p);
+      // -slots/2 is slots/2 again
+      if (2 * p < slots) negative.push_back(normalize(-static_cast<int64_t>(p)));
+    }
+    if (positive.size() > maxKeys) {
+      OPENFHE_THROW("rotation key budget is below log2(slots) = " + std::to_string(positive.size()));
+    }
+
+    keyIndices = positive;
+    std::vector<int32_t> candidates;
+    if (positive.size() + negative.size() <= maxKeys) {
+      keyIndices.insert(keyIndices.end(), negative.begin(), negative.end());
+    } else {
+      candidates = negative;
+    }
+    for (const auto &kv : frequency) candidates.push_back(kv.first);
+
+    // the powers of two reach every rotation, so every entry is finite
+    std::vector<uint32_t> steps(slots);
+    const RotationPlan basePlan(slots, keyIndices);
+    for (uint32_t r = 0; r < slots; r++) steps[r] = basePlan.GetKeySwitches(r);
+    const auto workloadCost = [&](int32_t key) {
+      uint64_t total = 0;
+      for (const auto &kv : frequency) {
+        total += static_cast<uint64_t>(GetKeySwitchesWithKey(steps, kv.first, key)) * kv.second;
+      }
+      return total;
+    };
+
+    // greedily add the candidate that lowers the workload's key switches most,
+    // scoring it over the workload's indices only
+    auto cost = basePlan.GetWorkloadKeySwitches(frequency);
+    while (keyIndices.size() < maxKeys) {
+      auto best = candidates.end();
+      for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+        if (std::find(keyIndices.begin(), keyIndices.end(), *it) != keyIndices.end()) continue;
+        const auto candidateCost = workloadCost(*it);
+        if (candidateCost < cost) {
+          cost = candidateCost;
+          best = it;
+        }
+      }
+      if (best == candidates.end()) break;
+      keyIndices.push_back(*best);
+      // entries only shrink, so updating in place stays exact
+      for (uint32_t r = 0; r < slots; r++) steps[r] = GetKeySwitchesWithKey(steps, r, *best);
+    }
+  }
+
+  auto plan = std::make_shared<RotationPlan>(slots, std::move(keyIndices));
+  plan->SetWorkload(frequency);
+  return plan;
+}
+
+/**
+ * @brief Generate the rotation keys of a plan and let EvalAtIndex() compose
+ * rotations for ciphertexts encrypted under this key.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param privateKey - private key.
+ * @param plan - plan returned by PlanRotationKeys().
+ */
+template<typename Element>
+void EvalAtIndexKeyGenPlanned(const CryptoContext<Element> &cryptoCtx,
+                              const PrivateKey<Element> privateKey,
+                              const std::shared_ptr<RotationPlan> plan) {
+  cryptoCtx->EvalAtIndexKeyGen(privateKey, plan->GetKeyIndices());
+  GetRotationPlans()[privateKey->GetKeyTag()] = plan;
+}
+
+/**
+ * @brief Whether a rotation key for an index exists under a key tag.
+ */
+template<typename Element>
+bool HasRotationKey(const CryptoContext<Element> &cryptoCtx, const std::string &keyTag, int32_t index) {
+  const auto &allKeys = CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys();
+  const auto it = allKeys.find(keyTag);
+  if (it == allKeys.end() || it->second == nullptr) return false;
+  const auto autoIndices = cryptoCtx->FindAutomorphismIndices(std::vector<int32_t>{index});
+  return !autoIndices.empty() && it->second->count(autoIndices[0]) > 0;
+}
+
+/**
+ * @brief Rotate a ciphertext. A rotation key of its own is used directly;
+ * otherwise the rotation is composed from the generating set of the plan
+ * registered for the ciphertext's key tag, if the plan reaches it.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param ciphertext - Input ciphertext.
+ * @param index - rotation amount.
+ * @return rotated ciphertext.
+ */
+template<typename Element>
+Ciphertext<Element> EvalAtIndexPlanned(const CryptoContext<Element> &cryptoCtx,
+                                       ConstCiphertext<Element> ciphertext,
+                                       int32_t index) {
+  const auto &keyTag = ciphertext->GetKeyTag();
+  const auto plan = FindRotationPlan(keyTag);
+  if (plan == nullptr || !plan->CanRotate(index) || HasRotationKey(cryptoCtx, keyTag, index)) {
+    return cryptoCtx->EvalAtIndex(ciphertext, index);
+  }
+
+  const auto steps = plan->Decompose(index);
+  if (steps.empty()) return ciphertext->Clone();
+
+  // each step is one automorphism with its key switch
+  Ciphertext<Element> result;
+  for (size_t i = 0; i < steps.size(); i++) {
+    TraceSpan span("Automorphism", "openfhe");
+    result = i == 0 ? cryptoCtx->EvalAtIndex(ciphertext, steps[0]) : cryptoCtx->EvalAtIndex(result, steps[i]);
+  }
+  return result;
+}
+
+std::vector<int32_t> GetRotationPlanKeyIndices(const RotationPlan &plan) { return plan.GetKeyIndices(); }
+
+void ClearRotationPlan(const std::string &keyTag) { GetRotationPlans().erase(keyTag); }
+
+void ClearRotationPlans() { GetRotationPlans().clear(); }
+
+EMSCRIPTEN_BINDINGS(rotation_planner) {
+  class_<RotationPlan>("RotationPlan")
+      .smart_ptr<std::shared_ptr<RotationPlan>>("RotationPlan")
+      .function("GetKeyIndices", &GetRotationPlanKeyIndices)
+      .function("GetNumKeys", &RotationPlan::GetNumKeys)
+      .function("GetSlots", &RotationPlan::GetSlots)
+      .function("GetKeySwitches", &RotationPlan::GetKeySwitches)
+      .function("GetExtraKeySwitches", &RotationPlan::GetExtraKeySwitches)
+      .function("GetMaxKeySwitches", &RotationPlan::GetMaxKeySwitches);
+  emscripten::function("ClearRotationPlans", &ClearRotationPlans);
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef _OPENFHEWEB_PKE_SNAPSHOT_EM_H
+#define _OPENFHEWEB_PKE_SNAPSHOT_EM_H
+
+#include <array>
+
+#include "core/serial_em.h"
+#include "context_cache_em.h"
+using namespace lbcrypto;
+
+// A context snapshot brings a generated CryptoContext back in a new process
+// without the prime and root-of-unity search of GenCryptoContext* and without
+// building its NTT twiddle tables again:
+//
+//   char[8]  magic "OFHESNAP"
+//   uint32   format version
+//   uint32   NATIVEINT of the backend that wrote the snapshot
+//   uint32   ring dimension
+//   uint32   number of moduli (the Q towers, then the P towers)
+//   per modulus:
+//     NativeInteger  modulus, full width
+//     per NTT table (see GetNTTTableMaps()):
+//       uint32         length, 0 if the table was not built
+//       NativeInteger  values[length]
+//   uint64   payload length
+//   bytes    binary serialization of the CryptoContext
+//
+// The moduli and roots of the Q towers travel in the payload. Restoring
+// loads the twiddle tables into OpenFHE's per-modulus NTT cache, where
+// PrecomputeCRTTables() finds them instead of computing them. OpenFHE has no
+// way to pass in the rest of its CRT state, so PrecomputeCRTTables() still
+// selects the P moduli and their roots and computes the basis-extension
+// constants, which is O(towers^2) scalar work. That happens when the policy
+// says, by default on first use of the context.
+const char kSnapshotMagic[8] = {'O', 'F', 'H', 'E', 'S', 'N', 'A', 'P'};
+const uint32_t kSnapshotVersion = 2;
+
+/**
+ * @brief OpenFHE's NTT tables for one modulus, in snapshot order.
+ */
+inline std::array<std::map<NativeInteger, NativeVector> *, 6> GetNTTTableMaps() {
+  using FTT = ChineseRemainderTransformFTT<NativeVector>;
+  return {&FTT::m_rootOfUnityReverseTableByModulus,
+          &FTT::m_rootOfUnityInverseReverseTableByModulus,
+          &FTT::m_rootOfUnityPreconReverseTableByModulus,
+          &FTT::m_rootOfUnityInversePreconReverseTableByModulus,
+          &FTT::m_cycloOrderInverseTableByModulus,
+          &FTT::m_cycloOrderInversePreconTableByModulus};
+}
+
+/**
+ * @brief Export a generated CryptoContext together with the NTT tables of
+ * its moduli.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @return snapshot as a Uint8Array.
+ */
+template<typename Element>
+emscripten::val ExportContextSnapshot(const CryptoContext<Element> &cryptoCtx) {
+  // the P moduli only exist once the CRT tables are built
+  EnsureCRTTables(cryptoCtx);
+
+  std::vector<NativeInteger> moduli;
+  for (const auto &tower : cryptoCtx->GetElementParams()->GetParams()) moduli.push_back(tower->GetModulus());
+  auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cryptoCtx->GetCryptoParameters());
+  if (cryptoParams != nullptr && cryptoParams->GetParamsP() != nullptr) {
+    for (const auto &tower : cryptoParams->GetParamsP()->GetParams()) moduli.push_back(tower->GetModulus());
+  }
+
+  std::ostringstream payload;
+  Serial::Serialize(cryptoCtx, payload, SerType::BINARY);
+  const auto payloadStr = payload.str();
+
+  std::ostringstream outputBuffer;
+  outputBuffer.write(kSnapshotMagic, sizeof(kSnapshotMagic));
+  WriteRaw<uint32_t>(outputBuffer, kSnapshotVersion);
+  WriteRaw<uint32_t>(outputBuffer, NATIVEINT);
+  WriteRaw<uint32_t>(outputBuffer, cryptoCtx->GetRingDimension());
+  WriteRaw<uint32_t>(outputBuffer, moduli.size());
+  for (const auto &modulus : moduli) {
+    WriteRaw<NativeInteger>(outputBuffer, modulus);
+    for (auto tables : GetNTTTableMaps()) {
+      const auto it = tables->find(modulus);
+      const uint32_t length = it == tables->end() ? 0 : it->second.GetLength();
+      WriteRaw<uint32_t>(outputBuffer, length);
+      if (length) {
+        outputBuffer.write(reinterpret_cast<const char *>(&it->second[0]), length * sizeof(NativeInteger));
+      }
+    }
+  }
+  WriteRaw<uint64_t>(outputBuffer, payloadStr.size());
+  outputBuffer.write(payloadStr.data(), payloadStr.size());
+
+  return stringstreamToTypedArray(outputBuffer);
+}
+
+/**
+ * @brief Restore a CryptoContext from a snapshot written by
+ * ExportContextSnapshot().
+ * @param jsBuf - snapshot as a Uint8Array.
+ * @param policy - when to build the remaining CRT tables of the context.
+ * @return CryptoContext.
+ */
+template<typename Element>
+CryptoContext<Element> RestoreContextSnapshot(const emscripten::val &jsBuf, CRTPrecomputePolicy policy) {
+  auto stream = typedArrayToStringstream(jsBuf);
+
+  char magic[sizeof(kSnapshotMagic)];
+  if (!stream.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), kSnapshotMagic)) {
+    OPENFHE_THROW("not a context snapshot");
+  }
+  if (ReadRaw<uint32_t>(stream) != kSnapshotVersion) {
+    OPENFHE_THROW("unsupported context snapshot version");
+  }
+  if (ReadRaw<uint32_t>(stream) != NATIVEINT) {
+    OPENFHE_THROW("context snapshot was written by a different native backend");
+  }
+  const auto ringDim = ReadRaw<uint32_t>(stream);
+  const auto numModuli = ReadRaw<uint32_t>(stream);
+
+  // tables already cached for a modulus, e.g. by an earlier restore, are kept
+  std::vector<NativeInteger> moduli(numModuli);
+  for (auto &modulus : moduli) {
+    modulus = ReadRaw<NativeInteger>(stream);
+    for (auto tables : GetNTTTableMaps()) {
+      const auto length = ReadRaw<uint32_t>(stream);
+      if (length > ringDim) OPENFHE_THROW("context snapshot table is larger than the ring dimension");
+      NativeVector table(length, modulus);
+      if (length && !stream.read(reinterpret_cast<char *>(&table[0]), length * sizeof(NativeInteger))) {
+        OPENFHE_THROW("truncated context snapshot");
+      }
+      if (length && tables->find(modulus) == tables->end()) tables->emplace(modulus, std::move(table));
+    }
+  }
+
+  const auto payloadLength = ReadRaw<uint64_t>(stream);
+  std::string payload(payloadLength, '\0');
+  if (!stream.read(&payload[0], payloadLength)) {
+    OPENFHE_THROW("truncated context snapshot");
+  }
+  std::istringstream payloadStream(payload);
+  auto cc = DeserializeCryptoContextWithPolicy<Element>(payloadStream, JsSerType::BINARY, policy);
+  if (cc == nullptr) return nullptr;
+
+  // the header has to describe the restored context
+  const auto towers = cc->GetElementParams()->GetParams();
+  if (cc->GetRingDimension() != ringDim || towers.size() > numModuli) {
+    OPENFHE_THROW("context snapshot header does not match its payload");
+  }
+  for (size_t i = 0; i < towers.size(); i++) {
+    if (towers[i]->GetModulus() != moduli[i]) OPENFHE_THROW("context snapshot header does not match its payload");
+  }
+  return cc;
+}
+
+EMSCRIPTEN_BINDINGS(snapshot) {
+  emscripten::function("ExportContextSnapshot", Traced<&ExportContextSnapshot<DCRTPoly>>("ExportContextSnapshot"));
+  emscripten::function("RestoreContextSnapshot", Traced<&RestoreContextSnapshot<DCRTPoly>>("RestoreContextSnapshot"),
+                       allow_raw_pointers());
+}
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef _OPENFHEWEB_PKE_THRESHOLD_EM_H
+#define _OPENFHEWEB_PKE_THRESHOLD_EM_H
+
+#include "element_codec.h"
+using namespace lbcrypto;
+
+// Batched threshold decryption with a compact partial-decryption format.
+//
+// A partial decryption has a single polynomial, so instead of a full cereal
+// ciphertext each item carries the ciphertext metadata and that polynomial
+// with its coefficients packed to the tower bit width. A batch is
+//
+//   char[8]  magic "OFHEPDEC"
+//   uint32   number of items
+//   per item: ciphertext metadata, packed element
+//
+// Lead/Main stream the ciphertexts one at a time into the batch, so only one
+// partial decryption is alive at a time; Fusion walks all parties' batches in
+// lockstep the same way.
+const char kPartialBatchMagic[8] = {'O', 'F', 'H', 'E', 'P', 'D', 'E', 'C'};
+
+template<typename Element>
+emscripten::val MultipartyDecryptBatch(const CryptoContext<Element> &cryptoCtx,
+                                       const PrivateKey<Element> privateKey,
+                                       const emscripten::val &ciphertextVecJs,
+                                       uint32_t numTowers,
+                                       bool lead) {
+  const auto ciphertextVec = vecFromJSArray<Ciphertext<Element>>(ciphertextVecJs);
+
+  std::ostringstream outputBuffer;
+  outputBuffer.write(kPartialBatchMagic, sizeof(kPartialBatchMagic));
+  WriteRaw<uint32_t>(outputBuffer, ciphertextVec.size());
+  for (const auto &ciphertext : ciphertextVec) {
+    // every party has to compress to the same number of towers
+    auto input = numTowers > 0 && numTowers < ciphertext->GetElements()[0].GetNumOfElements()
+        ? cryptoCtx->Compress(ciphertext, numTowers) : ciphertext;
+    const auto partial = lead ? cryptoCtx->MultipartyDecryptLead({input}, privateKey)
+                              : cryptoCtx->MultipartyDecryptMain({input}, privateKey);
+    WriteCiphertextMetadata(outputBuffer, *partial[0]);
+    WritePackedElement(outputBuffer, partial[0]->GetElements()[0]);
+  }
+  return stringstreamToTypedArray(outputBuffer);
+}
+
+/**
+ * @brief Threshold FHE: lead party's partial decryption of a batch of
+ * ciphertexts in the compact format.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param privateKey - secret key share used for decryption.
+ * @param ciphertextVecJs - ciphertexts to decrypt.
+ * @param numTowers - towers kept before decrypting (0 keeps all); must be the
+ * same for every party.
+ * @return batch of partial decryptions as a Uint8Array.
+ */
+template<typename Element>
+emscripten::val MultipartyDecryptLeadBatch(const CryptoContext<Element> &cryptoCtx,
+                                           const PrivateKey<Element> privateKey,
+                                           const emscripten::val &ciphertextVecJs,
+                                           uint32_t numTowers) {
+  return MultipartyDecryptBatch(cryptoCtx, privateKey, ciphertextVecJs, numTowers, true);
+}
+
+/**
+ * @brief Threshold FHE: partial decryption of a batch of ciphertexts by any
+ * party other than the lead one, in the compact format.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param privateKey - secret key share used for decryption.
+ * @param ciphertextVecJs - ciphertexts to decrypt.
+ * @param numTowers - towers kept before decrypting (0 keeps all); must be the
+ * same for every party.
+ * @return batch of partial decryptions as a Uint8Array.
+ */
+template<typename Element>
+emscripten::val MultipartyDecryptMainBatch(const CryptoContext<Element> &cryptoCtx,
+                                           const PrivateKey<Element> privateKey,
+                                           const emscripten::val &ciphertextVecJs,
+                                           uint32_t numTowers) {
+  return MultipartyDecryptBatch(cryptoCtx, privateKey, ciphertextVecJs, numTowers, false);
+}
+
+/**
+ * @brief Threshold FHE: combine the partial decryption batches of all
+ * parties.
+ * @param cryptoCtx - Reference to CryptoContext from JS.
+ * @param batchesJs - one batch per party, lead party first.
+ * @return JS array with one Plaintext per ciphertext.
+ */
+template<typename Element>
+emscripten::val MultipartyDecryptFusionBatch(const CryptoContext<Element> &cryptoCtx,
+                                             const emscripten::val &batchesJs) {
+  const auto numParties = batchesJs["length"].as<uint32_t>();
+  std::vector<std::istringstream> streams;
+  uint32_t numItems = 0;
+  for (uint32_t p = 0; p < numParties; p++) {
+    streams.push_back(typedArrayToStringstream(batchesJs[p]));
+    char magic[sizeof(kPartialBatchMagic)];
+    if (!streams[p].read(magic, sizeof(magic)) ||
+        !std::equal(magic, magic + sizeof(magic), kPartialBatchMagic)) {
+      OPENFHE_THROW("not a partial decryption batch");
+    }
+    const auto count = ReadRaw<uint32_t>(streams[p]);
+    if (p > 0 && count != numItems) OPENFHE_THROW("partial decryption batches differ in length");
+    numItems = count;
+  }
+
+  auto result = emscripten::val::array();
+  std::vector<Ciphertext<Element>> partials(numParties);
+  for (uint32_t i = 0; i < numItems; i++) {
+    for (uint32_t p = 0; p < numParties; p++) {
+      auto partial = std::make_shared<CiphertextImpl<Element>>(cryptoCtx);
+      ReadCiphertextMetadata(streams[p], *partial);
+      partial->SetElements({ReadPackedElement(streams[p], cryptoCtx)});
+      partials[p] = partial;
+    }
+    Plaintext plaintext;
+    cryptoCtx->MultipartyDecryptFusion(partials, &plaintext);
+    result.call<void>("push", plaintext);
+  }
+  return result;
+}
+
+#endif
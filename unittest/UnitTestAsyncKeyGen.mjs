@@ -0,0 +1,101 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {copyVecToJs, setupParamsBFV,} from "./common.mjs";
+
+async function setupContext(module) {
+    let params = await new module.CCParamsCryptoContextBFVRNS();
+    params = await setupParamsBFV(params);
+    const cc = new module.GenCryptoContextBFV(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    cc.Enable(module.PKESchemeFeature.KEYSWITCH);
+    cc.Enable(module.PKESchemeFeature.LEVELEDSHE);
+    cc.Enable(module.PKESchemeFeature.ADVANCEDSHE);
+    return cc;
+}
+
+async function TestAsyncKeyGen() {
+    const module = await factory();
+    const cc = await setupContext(module);
+
+    try {
+        const progress = [];
+        const kp = await cc.KeyGenAsync({onProgress: (done, total) => progress.push([done, total])});
+        assert.deepEqual(progress, [[1, 1]]);
+        await cc.EvalMultKeyGenAsync(kp.secretKey);
+        await cc.EvalSumKeyGenAsync(kp.secretKey);
+
+        const x = [1, 2, 3];
+        const ciphertext = cc.Encrypt(kp.publicKey,
+            cc.MakePackedPlaintext(module.MakeVectorInt64Clipped(x)));
+        const product = cc.Decrypt(kp.secretKey, cc.EvalMultCipherCipher(ciphertext, ciphertext));
+        product.SetLength(x.length);
+        assert.deepEqual([1, 4, 9], copyVecToJs(product.GetPackedValue()));
+        const sum = cc.Decrypt(kp.secretKey, cc.EvalSum(ciphertext, 8));
+        sum.SetLength(1);
+        assert.deepEqual([6], copyVecToJs(sum.GetPackedValue()));
+
+        const controller = new AbortController();
+        controller.abort();
+        await assert.rejects(cc.EvalMultKeyGenAsync(kp.secretKey, {signal: controller.signal}));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+async function TestAsyncRotationKeyGen() {
+    const module = await factory();
+    const cc = await setupContext(module);
+
+    try {
+        const kp = await cc.KeyGenAsync();
+        await cc.EvalMultKeyGenAsync(kp.secretKey);
+
+        const indices = [1, 2, 3, 4, 5];
+        const progress = [];
+        await cc.EvalAtIndexKeyGenAsync(kp.secretKey, indices, {
+            chunkSize: 2,
+            onProgress: (done, total) => progress.push([done, total]),
+        });
+        assert.deepEqual(progress, [[2, 5], [4, 5], [5, 5]]);
+
+        const x = [1, 2, 3, 4, 5, 6];
+        const ciphertext = cc.Encrypt(kp.publicKey,
+            cc.MakePackedPlaintext(module.MakeVectorInt64Clipped(x)));
+        const decrypted = cc.Decrypt(kp.secretKey, cc.EvalAtIndex(ciphertext, 5));
+        decrypted.SetLength(1);
+        assert.deepEqual([6], copyVecToJs(decrypted.GetPackedValue()));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+async function TestAsyncKeyGenCancellation() {
+    const module = await factory();
+    const cc = await setupContext(module);
+    const kp = cc.KeyGen();
+
+    const controller = new AbortController();
+    const promise = cc.EvalAtIndexKeyGenAsync(kp.secretKey, [1, 2, 3, 4], {
+        chunkSize: 1,
+        onProgress: (done) => {
+            if (done === 1) controller.abort();
+        },
+        signal: controller.signal,
+    });
+    await assert.rejects(promise);
+}
+
+describe('CryptoContext', () => {
+    describe('#KeyGenAsync()', () => {
+        it('Should generate working key pairs, EvalMult and EvalSum keys', TestAsyncKeyGen)
+            .timeout(20000)
+    });
+    describe('#EvalAtIndexKeyGenAsync()', () => {
+        it('Should generate rotation keys in chunks and report progress', TestAsyncRotationKeyGen)
+            .timeout(20000)
+        it('Should stop when the signal is aborted', TestAsyncKeyGenCancellation)
+            .timeout(20000)
+    });
+});
@@ -0,0 +1,109 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_binfhe.js'
+
+const truthTables = {
+    AND: (a, b) => a & b,
+    OR: (a, b) => a | b,
+    NAND: (a, b) => 1 - (a & b),
+    NOR: (a, b) => 1 - (a | b),
+    XOR: (a, b) => a ^ b,
+    XNOR: (a, b) => 1 - (a ^ b),
+};
+
+async function setupCC(module) {
+    const cc = new module.BinFHEContext();
+    cc.GenerateBinFHEContext(module.BINFHE_PARAMSET.TOY, module.BINFHE_METHOD.GINX);
+    const sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+    return [cc, sk];
+}
+
+async function TestBinFHEGates() {
+    const module = await factory();
+    const [cc, sk] = await setupCC(module);
+
+    try {
+        const ct0 = cc.Encrypt(sk, 0);
+        const ct1 = cc.Encrypt(sk, 1);
+        assert.equal(0, cc.Decrypt(sk, ct0));
+        assert.equal(1, cc.Decrypt(sk, cc.EvalNOT(ct0)));
+        assert.equal(1, cc.Decrypt(sk, cc.Bootstrap(ct1)));
+        assert.equal(1, cc.Decrypt(sk, cc.EvalBinGate(module.BINGATE.NAND, ct0, ct1)));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+async function TestBinFHEBatchedGates() {
+    const module = await factory();
+    const [cc, sk] = await setupCC(module);
+
+    try {
+        // every gate on every input combination in one call
+        const a = [], b = [], gates = [], expected = [];
+        for (const [name, table] of Object.entries(truthTables)) {
+            for (const [x, y] of [[0, 0], [0, 1], [1, 0], [1, 1]]) {
+                a.push(x);
+                b.push(y);
+                gates.push(module.BINGATE[name]);
+                expected.push(table(x, y));
+            }
+        }
+        const cts1 = cc.EncryptBits(sk, Uint8Array.from(a));
+        const cts2 = cc.EncryptBits(sk, b);
+
+        const out = cc.EvalBinGates(gates, cts1, cts2);
+        assert.deepEqual(Uint8Array.from(expected), cc.DecryptBits(sk, out));
+
+        // a single gate applies to all pairs
+        const ands = cc.EvalBinGates(module.BINGATE.AND, cts1, cts2);
+        assert.deepEqual(Uint8Array.from(a.map((x, i) => x & b[i])), cc.DecryptBits(sk, ands));
+        assert.deepEqual(Uint8Array.from(a.map(x => 1 - x)), cc.DecryptBits(sk, cc.EvalNOTs(cts1)));
+
+        assert.throws(() => cc.EvalBinGates(gates, cts1, cts2.slice(1)));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+async function TestBinFHESerialization() {
+    const module = await factory();
+    const [cc, sk] = await setupCC(module);
+
+    try {
+        const ctBuf = module.SerializeBinFHEContextToBuffer(cc, module.SerType.BINARY);
+        const keyBuf = module.SerializeBTKeyToBuffer(cc, module.SerType.BINARY);
+        const skBuf = module.SerializeLWEPrivateKeyToBuffer(sk, module.SerType.BINARY);
+
+        // a second context evaluates gates with the loaded key only
+        const cc2 = module.DeserializeBinFHEContextFromBuffer(ctBuf, module.SerType.BINARY);
+        module.BTKeyLoadFromBuffer(cc2, keyBuf, module.SerType.BINARY);
+        const sk2 = module.DeserializeLWEPrivateKeyFromBuffer(skBuf, module.SerType.BINARY);
+
+        const ct1 = cc.Encrypt(sk, 1);
+        const ctBits = module.DeserializeLWECiphertextFromBuffer(
+            module.SerializeLWECiphertextToBuffer(ct1, module.SerType.BINARY), module.SerType.BINARY);
+        const out = cc2.EvalBinGate(module.BINGATE.XOR, ctBits, cc2.Encrypt(sk2, 1));
+        assert.equal(0, cc.Decrypt(sk, out));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('BinFHEContext', () => {
+    describe('#EvalBinGate()', () => {
+        it('Should evaluate gates on encrypted bits', TestBinFHEGates)
+            .timeout(60000)
+    });
+    describe('#EvalBinGates()', () => {
+        it('Should evaluate a layer of gates in one call', TestBinFHEBatchedGates)
+            .timeout(60000)
+    });
+    describe('#BTKeyLoadFromBuffer()', () => {
+        it('Should evaluate gates with a deserialized bootstrapping key', TestBinFHESerialization)
+            .timeout(60000)
+    });
+});
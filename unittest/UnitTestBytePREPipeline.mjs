@@ -0,0 +1,57 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {setupParamsBFV,} from "./common.mjs";
+
+async function TestBytePREPipelineRoundTrip() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextBFVRNS();
+    params = await setupParamsBFV(params);
+    const cc = new module.GenCryptoContextBFV(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    cc.Enable(module.PKESchemeFeature.KEYSWITCH);
+    cc.Enable(module.PKESchemeFeature.LEVELEDSHE);
+    cc.Enable(module.PKESchemeFeature.PRE);
+
+    try {
+        const alice = cc.KeyGen();
+        const bob = cc.KeyGen();
+        const reKey = cc.ReKeyGenPrivPub(alice.secretKey, bob.publicKey);
+
+        const pipeline = new module.BytePREPipeline(cc, alice.publicKey, reKey);
+        // t = 65537 carries 16 bits, i.e. two bytes, per slot
+        assert.equal(pipeline.GetBytesPerCiphertext(), 2 * cc.GetRingDimension());
+
+        const payload = new Uint8Array(3 * pipeline.GetBytesPerCiphertext() + 17);
+        for (let i = 0; i < payload.length; i++) payload[i] = (i * 31 + 7) & 0xff;
+
+        // odd chunk sizes make records straddle chunk boundaries
+        const records = [];
+        const chunkSize = 100;
+        for (let offset = 0; offset < payload.length; offset += chunkSize) {
+            records.push(pipeline.Push(payload.subarray(offset, offset + chunkSize)));
+        }
+        records.push(pipeline.Finish());
+        assert.equal(pipeline.GetBytesProcessed(), payload.length);
+
+        const joined = new Uint8Array(records.reduce((sum, r) => sum + r.length, 0));
+        let offset = 0;
+        records.forEach(r => {
+            joined.set(r, offset);
+            offset += r.length;
+        });
+
+        const decrypted = cc.DecryptByteRecords(bob.secretKey, joined);
+        assert.deepEqual(payload, decrypted);
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('BytePREPipeline', () => {
+    describe('#Push()', () => {
+        it('Should re-encrypt a byte stream for the recipient', TestBytePREPipelineRoundTrip)
+            .timeout(20000)
+    });
+});
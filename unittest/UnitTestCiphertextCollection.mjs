@@ -0,0 +1,79 @@
+import assert from 'assert'
+import fs from 'fs'
+import os from 'os'
+import path from 'path'
+import factory from '../lib/openfhe_pke.js'
+import {copyVecToJs, setupParamsCKKS,} from "./common.mjs";
+
+async function TestCiphertextCollection() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextCKKSRNS();
+    params = await setupParamsCKKS(params);
+    const cc = new module.GenCryptoContextCKKS(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    const kp = cc.KeyGen();
+
+    const file = path.join(os.tmpdir(), `UnitTestCiphertextCollection_${process.pid}.bin`);
+    try {
+        const rows = i => [i, i + 0.5, -i];
+        const fileWriter = new module.CiphertextCollectionWriter(cc, file);
+        const memoryWriter = new module.CiphertextCollectionWriter(cc, undefined, {encoding: 'raw'});
+        for (let i = 0; i < 20; i++) {
+            const ciphertext = cc.Encrypt(kp.publicKey, cc.MakeCKKSPackedPlaintext(new module.VectorDouble(rows(i))));
+            assert.equal(fileWriter.append(ciphertext), i);
+            memoryWriter.append(ciphertext);
+            ciphertext.delete();
+        }
+        assert.equal(fileWriter.close(), undefined);
+        const bytes = memoryWriter.close();
+
+        for (const source of [file, bytes]) {
+            const reader = new module.CiphertextCollectionReader(cc, source, {cacheSize: 2});
+            assert.equal(reader.length, 20);
+            for (const i of [13, 2, 13, 19, 7, 13]) {
+                const ciphertext = reader.get(i);
+                const decrypted = cc.Decrypt(kp.secretKey, ciphertext);
+                decrypted.SetLength(3);
+                const got = copyVecToJs(decrypted.GetRealPackedValue());
+                rows(i).forEach((value, idx) => assert(Math.abs(value - got[idx]) < 1e-3));
+                ciphertext.delete();
+            }
+            // 13 is evicted by 19 and 7 before its third lookup
+            assert.deepEqual([reader.stats.hits, reader.stats.misses], [1, 5]);
+            assert.throws(() => reader.get(20), RangeError);
+
+            // get() hands out a copy; negating it leaves the cached 7 intact
+            const copy = reader.get(7);
+            cc.EvalNegateInPlace(copy);
+            copy.delete();
+            const cached = reader.get(7);
+            const decrypted = cc.Decrypt(kp.secretKey, cached);
+            decrypted.SetLength(3);
+            const got = copyVecToJs(decrypted.GetRealPackedValue());
+            rows(7).forEach((value, idx) => assert(Math.abs(value - got[idx]) < 1e-3));
+            cached.delete();
+            reader.close();
+        }
+
+        // a context with another moduli chain is rejected
+        let otherParams = await new module.CCParamsCryptoContextCKKSRNS();
+        otherParams = await setupParamsCKKS(otherParams);
+        otherParams.SetMultiplicativeDepth(1);
+        const other = new module.GenCryptoContextCKKS(otherParams);
+        assert.notEqual(module.GetContextId(other), module.GetContextId(cc));
+        assert.throws(() => new module.CiphertextCollectionReader(other, file), /different context/);
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    } finally {
+        fs.rmSync(file, {force: true});
+    }
+}
+
+describe('CiphertextCollection', () => {
+    describe('#get()', () => {
+        it('Should read single ciphertexts from a file or buffer', TestCiphertextCollection)
+            .timeout(30000)
+    });
+});
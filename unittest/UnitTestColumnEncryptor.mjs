@@ -0,0 +1,117 @@
+import assert from 'assert'
+import {Writable} from 'stream'
+import factory from '../lib/openfhe_pke.js'
+import {setupParamsBFV, setupParamsCKKS,} from "./common.mjs";
+
+function concat(records) {
+    const joined = new Uint8Array(records.reduce((sum, r) => sum + r.length, 0));
+    let offset = 0;
+    records.forEach(r => {
+        joined.set(r, offset);
+        offset += r.length;
+    });
+    return joined;
+}
+
+async function TestColumnEncryptorCKKS() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextCKKSRNS();
+    params = await setupParamsCKKS(params);
+    const cc = new module.GenCryptoContextCKKS(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+
+    try {
+        const kp = cc.KeyGen();
+        const encryptor = new module.ColumnEncryptor(cc, kp.publicKey);
+        assert.equal(encryptor.GetRowsPerCiphertext(), 8);
+
+        const column = new Float64Array(45);
+        for (let i = 0; i < column.length; i++) column[i] = Math.sin(i) * 100;
+
+        // chunks of 7 rows make ciphertexts straddle chunk boundaries
+        const records = [];
+        for (let offset = 0; offset < column.length; offset += 7) {
+            records.push(encryptor.Push(column.subarray(offset, offset + 7)));
+        }
+        records.push(encryptor.Finish());
+        assert.equal(encryptor.GetRowsProcessed(), column.length);
+
+        const decrypted = cc.DecryptColumnRecords(kp.secretKey, concat(records));
+        assert.equal(decrypted.length, column.length);
+        column.forEach((value, idx) => assert(Math.abs(value - decrypted[idx]) < 1e-3));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+async function TestEncryptColumnToStreamBFV() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextBFVRNS();
+    params = await setupParamsBFV(params);
+    const cc = new module.GenCryptoContextBFV(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+
+    try {
+        const kp = cc.KeyGen();
+        const column = new Int32Array(3 * cc.GetRingDimension() + 5);
+        for (let i = 0; i < column.length; i++) column[i] = (i * 37) % 1000 - 500;
+
+        async function* chunks() {
+            for (let offset = 0; offset < column.length; offset += 100) {
+                yield column.subarray(offset, offset + 100);
+            }
+        }
+
+        // a small highWaterMark exercises the backpressure path
+        const written = [];
+        const writable = new Writable({
+            highWaterMark: 1024,
+            write(chunk, encoding, callback) {
+                written.push(new Uint8Array(chunk));
+                setImmediate(callback);
+            }
+        });
+        let progressCalls = 0;
+        const stats = await module.EncryptColumnToStream(cc, kp.publicKey, chunks(), writable, {
+            onProgress: rows => {
+                progressCalls++;
+                assert(rows <= column.length);
+            }
+        });
+        await new Promise(resolve => writable.end(resolve));
+
+        assert.equal(stats.rows, column.length);
+        assert.equal(progressCalls, Math.ceil(column.length / 100));
+        const joined = concat(written);
+        assert.equal(stats.bytes, joined.length);
+
+        const decrypted = cc.DecryptColumnRecords(kp.secretKey, joined);
+        assert.deepEqual(Array.from(decrypted), Array.from(column));
+
+        // rows that would be truncated or wrap around the plaintext modulus are rejected
+        const encryptor = new module.ColumnEncryptor(cc, kp.publicKey);
+        const maxRow = Number((cc.GetPlaintextModulusBigInt() - 1n) / 2n);
+        assert.throws(() => encryptor.Push([1, 2.5]));
+        assert.throws(() => encryptor.Push([maxRow + 1]));
+        encryptor.Push([maxRow, -maxRow]);
+        const last = cc.DecryptColumnRecords(kp.secretKey, encryptor.Finish());
+        assert.deepEqual(Array.from(last), [maxRow, -maxRow]);
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('ColumnEncryptor', () => {
+    describe('#Push()', () => {
+        it('Should encrypt a real-valued column in chunks', TestColumnEncryptorCKKS)
+            .timeout(20000)
+    });
+    describe('EncryptColumnToStream()', () => {
+        it('Should stream an integer column to a writable', TestEncryptColumnToStreamBFV)
+            .timeout(20000)
+    });
+});
@@ -0,0 +1,79 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {setupCCCKKS, setupParamsCKKS} from "./common.mjs";
+
+const a = [0.25, 0.5, -0.75, 1.0];
+const b = [1.5, -0.125, 0.0, 2.0];
+
+function interleave(re, im) {
+    return Float64Array.from(re.flatMap((x, i) => [x, im[i]]));
+}
+
+function assertClose(expected, got) {
+    assert.equal(expected.length, got.length);
+    expected.forEach((x, i) => assert(Math.abs(x - got[i]) < 1e-3, `slot ${i}: expected ${x}, got ${got[i]}`));
+}
+
+async function setupCC(module) {
+    let params = await new module.CCParamsCryptoContextCKKSRNS();
+    params = await setupParamsCKKS(params);
+    const [cc, kp] = await setupCCCKKS(new module.GenCryptoContextCKKS(params));
+    cc.EvalConjugateKeyGen(kp.secretKey);
+    return [cc, kp];
+}
+
+async function TestCKKSComplexRoundTrip() {
+    const module = await factory();
+    const [cc, kp] = await setupCC(module);
+
+    try {
+        const plaintext = cc.MakeCKKSComplexPackedPlaintext(interleave(a, b));
+        const ciphertext = cc.Encrypt(kp.publicKey, plaintext);
+
+        const decrypted = cc.Decrypt(kp.secretKey, ciphertext);
+        decrypted.SetLength(a.length);
+        const got = decrypted.GetComplexPackedValue();
+        assert(got instanceof Float64Array);
+        assertClose(Array.from(interleave(a, b)), Array.from(got));
+
+        // conjugation negates the imaginary parts
+        const conjugated = cc.Decrypt(kp.secretKey, cc.EvalConjugate(ciphertext));
+        conjugated.SetLength(a.length);
+        assertClose(Array.from(interleave(a, b.map(x => -x))), Array.from(conjugated.GetComplexPackedValue()));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+async function TestCKKSComplexSplit() {
+    const module = await factory();
+    const [cc, kp] = await setupCC(module);
+
+    try {
+        // plain arrays are accepted as well
+        const ciphertext = cc.Encrypt(kp.publicKey, cc.MakeCKKSComplexPackedPlaintext(Array.from(interleave(a, b))));
+
+        const real = cc.Decrypt(kp.secretKey, cc.EvalRealPart(ciphertext));
+        real.SetLength(a.length);
+        assertClose(Array.from(interleave(a, [0, 0, 0, 0])), Array.from(real.GetComplexPackedValue()));
+
+        const imag = cc.Decrypt(kp.secretKey, cc.EvalImagPart(ciphertext));
+        imag.SetLength(b.length);
+        assertClose(Array.from(interleave(b, [0, 0, 0, 0])), Array.from(imag.GetComplexPackedValue()));
+
+        assert.throws(() => cc.MakeCKKSComplexPackedPlaintext(new Float64Array(3)));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('CryptoContext', () => {
+    describe('#MakeCKKSComplexPackedPlaintext()', () => {
+        it('Should round trip interleaved complex slots', TestCKKSComplexRoundTrip)
+            .timeout(20000)
+        it('Should split two packed real vectors', TestCKKSComplexSplit)
+            .timeout(20000)
+    });
+});
@@ -0,0 +1,105 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {copyVecToJs, setupParamsBFV,} from "./common.mjs";
+
+async function TestCachedDeserializationReusesContext() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextBFVRNS();
+    params = await setupParamsBFV(params);
+    const cc = new module.GenCryptoContextBFV(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    cc.Enable(module.PKESchemeFeature.LEVELEDSHE);
+
+    try {
+        const buffer = module.SerializeCryptoContextToBuffer(cc, module.SerType.BINARY);
+
+        // the native module is shared by all test files, so compare against the state before
+        const sizeBefore = module.GetCryptoContextCacheSize();
+        const missesBefore = module.GetCryptoContextCacheMisses();
+        const hitsBefore = module.GetCryptoContextCacheHits();
+
+        const cc1 = module.DeserializeCryptoContextFromBufferCached(
+            buffer, module.SerType.BINARY, module.CRTPrecomputePolicy.LAZY);
+        const cc2 = module.DeserializeCryptoContextFromBufferCached(
+            buffer, module.SerType.BINARY, module.CRTPrecomputePolicy.LAZY);
+
+        assert.equal(module.GetCryptoContextCacheMisses() - missesBefore, 1);
+        assert.equal(module.GetCryptoContextCacheHits() - hitsBefore, 1);
+        assert.equal(module.GetCryptoContextCacheSize() - sizeBefore, 1);
+        assert.equal(cc1.GetRingDimension(), cc.GetRingDimension());
+
+        module.EnsureCRTTables(cc2);
+        const kp = cc2.KeyGen();
+        const x = [1, 2, 3];
+        const plaintext = cc2.MakePackedPlaintext(module.MakeVectorInt64Clipped(x));
+        const ciphertext = cc2.Encrypt(kp.publicKey, plaintext);
+        const decrypted = cc2.Decrypt(kp.secretKey, ciphertext);
+        decrypted.SetLength(x.length);
+        assert.deepEqual(x, copyVecToJs(decrypted.GetPackedValue()));
+
+        module.ClearCryptoContextCache();
+        assert.equal(module.GetCryptoContextCacheSize(), 0);
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+async function TestLazyTablesBuiltOnFirstUse() {
+    const module = await factory();
+
+    const buffers = [];
+    for (const depth of [3, 4]) {
+        let params = await new module.CCParamsCryptoContextBFVRNS();
+        params = await setupParamsBFV(params);
+        params.SetMultiplicativeDepth(depth);
+        const cc = new module.GenCryptoContextBFV(params);
+        cc.Enable(module.PKESchemeFeature.PKE);
+        buffers.push(module.SerializeCryptoContextToBuffer(cc, module.SerType.BINARY));
+    }
+
+    try {
+        // forget the generated contexts, so deserializing builds new ones
+        module.ReleaseAllContexts();
+        const limit = module.GetCryptoContextCacheLimit();
+        module.ClearCryptoContextCache();
+        module.SetCryptoContextCacheLimit(1);
+
+        const cc = module.DeserializeCryptoContextFromBufferCached(
+            buffers[0], module.SerType.BINARY, module.CRTPrecomputePolicy.LAZY);
+        cc.Enable(module.PKESchemeFeature.PKE);
+        assert.ok(!module.AreCRTTablesReady(cc));
+
+        // the first traced call builds the tables
+        const kp = cc.KeyGen();
+        assert.ok(module.AreCRTTablesReady(cc));
+        const x = [1, 2, 3];
+        const ciphertext = cc.Encrypt(kp.publicKey, cc.MakePackedPlaintext(module.MakeVectorInt64Clipped(x)));
+        const decrypted = cc.Decrypt(kp.secretKey, ciphertext);
+        decrypted.SetLength(x.length);
+        assert.deepEqual(x, copyVecToJs(decrypted.GetPackedValue()));
+
+        // a second context evicts the least recently used one
+        const evictions = module.GetCryptoContextCacheEvictions();
+        module.DeserializeCryptoContextFromBufferCached(
+            buffers[1], module.SerType.BINARY, module.CRTPrecomputePolicy.EAGER);
+        assert.equal(module.GetCryptoContextCacheSize(), 1);
+        assert.equal(module.GetCryptoContextCacheEvictions() - evictions, 1);
+
+        module.SetCryptoContextCacheLimit(limit);
+        module.ClearCryptoContextCache();
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('Serialization', () => {
+    describe('#DeserializeCryptoContextFromBufferCached()', () => {
+        it('Should parse identical context bytes only once', TestCachedDeserializationReusesContext)
+            .timeout(10000)
+        it('Should build LAZY tables on first use and bound the cache', TestLazyTablesBuiltOnFirstUse)
+            .timeout(10000)
+    });
+});
@@ -0,0 +1,48 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {setupCCCKKS, setupParamsCKKS,} from "./common.mjs";
+
+async function TestSnapshotRoundTrip() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextCKKSRNS();
+    params = await setupParamsCKKS(params);
+    const cc = new module.GenCryptoContextCKKS(params);
+
+    try {
+        const snapshot = module.ExportContextSnapshot(cc);
+        module.ReleaseAllContexts();
+
+        let restored = module.RestoreContextSnapshot(snapshot, module.CRTPrecomputePolicy.LAZY);
+        assert.equal(restored.GetRingDimension(), cc.GetRingDimension());
+        assert.ok(!module.AreCRTTablesReady(restored));
+
+        let kp = undefined;
+        [restored, kp] = await setupCCCKKS(restored);
+        assert.ok(module.AreCRTTablesReady(restored));
+        const x = [0.25, 0.5, 1.0, 2.0];
+        const plaintext = restored.MakeCKKSPackedPlaintext(new module.VectorDouble(x));
+        const ciphertext = restored.Encrypt(kp.publicKey, plaintext);
+        const decrypted = restored.Decrypt(kp.secretKey, restored.EvalMult(ciphertext, ciphertext));
+        decrypted.SetLength(x.length);
+        const got = decrypted.GetRealPackedValue();
+        x.forEach((value, idx) => assert(Math.abs(value * value - got.get(idx)) < 1e-6));
+
+        // corrupted or truncated snapshots must be rejected
+        const corrupted = snapshot.slice();
+        corrupted[0] = 0;
+        assert.throws(() => module.RestoreContextSnapshot(corrupted, module.CRTPrecomputePolicy.EAGER));
+        assert.throws(() => module.RestoreContextSnapshot(snapshot.slice(0, snapshot.length / 2),
+            module.CRTPrecomputePolicy.EAGER));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('Serialization', () => {
+    describe('#RestoreContextSnapshot()', () => {
+        it('Should restore a usable context from a snapshot', TestSnapshotRoundTrip)
+            .timeout(20000)
+    });
+});
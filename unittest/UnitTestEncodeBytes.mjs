@@ -0,0 +1,57 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {setupCCBFV, setupParamsBFV,} from "./common.mjs";
+
+async function roundTrip(module, packing) {
+    let params = await new module.CCParamsCryptoContextBFVRNS();
+    params = await setupParamsBFV(params);
+    let cc = new module.GenCryptoContextBFV(params);
+    let kp = undefined;
+    [cc, kp] = await setupCCBFV(cc);
+
+    // t = 65537 carries 16 bits per slot or coefficient
+    const bytesPerPlaintext = cc.GetBytesPerPlaintext(packing);
+    assert.equal(bytesPerPlaintext, 2 * cc.GetRingDimension());
+
+    const payload = new Uint8Array(2 * bytesPerPlaintext + 3);
+    for (let i = 0; i < payload.length; i++) payload[i] = (i * 131 + 17) & 0xff;
+    // slots 0xffff and 0x8000 have the top bit set and lie above t / 2, so they
+    // are encoded as their centered representatives
+    payload.set([0xff, 0xff, 0x00, 0x80]);
+
+    const plaintexts = cc.EncodeBytes(payload, packing);
+    assert.equal(plaintexts.length, 3);
+
+    const decrypted = plaintexts.map(
+        plaintext => cc.Decrypt(kp.secretKey, cc.Encrypt(kp.publicKey, plaintext)));
+    assert.deepEqual(payload, cc.DecodeBytes(decrypted, payload.length, packing));
+}
+
+async function TestEncodeBytesPacked() {
+    const module = await factory();
+    try {
+        await roundTrip(module, module.BytePacking.PACKED);
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+async function TestEncodeBytesCoefPacked() {
+    const module = await factory();
+    try {
+        await roundTrip(module, module.BytePacking.COEF_PACKED);
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('CryptoContext', () => {
+    describe('#EncodeBytes()', () => {
+        it('Should round trip bytes in packed mode', TestEncodeBytesPacked)
+            .timeout(10000)
+        it('Should round trip bytes in coefficient mode', TestEncodeBytesCoefPacked)
+            .timeout(10000)
+    });
+});
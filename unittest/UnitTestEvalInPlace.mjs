@@ -0,0 +1,57 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {copyVecToJs, setupCCBFV, setupParamsBFV,} from "./common.mjs";
+
+function rotate(x, index) {
+    return x.slice(index).concat(x.slice(0, index));
+}
+
+async function TestBFVInPlaceAccumulate() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextBFVRNS();
+    params = await setupParamsBFV(params);
+    let cc = new module.GenCryptoContextBFV(params);
+    let kp = undefined;
+    [cc, kp] = await setupCCBFV(cc, [1]);
+
+    try {
+        const x = [1, 2, 3, 4];
+        const y = [5, 6, 7, 8];
+        // acc = -((x + y + y) - x) rotated left by one
+        const expected = rotate(y.map(v => -2 * v), 1);
+
+        const ctX = cc.Encrypt(kp.publicKey, cc.MakePackedPlaintext(module.MakeVectorInt64Clipped(x)));
+        const ctY = cc.Encrypt(kp.publicKey, cc.MakePackedPlaintext(module.MakeVectorInt64Clipped(y)));
+
+        const acc = cc.Encrypt(kp.publicKey, cc.MakePackedPlaintext(module.MakeVectorInt64Clipped(x)));
+        cc.EvalAddInPlace(acc, ctY);
+        cc.EvalAddInPlace(acc, ctY);
+        cc.EvalSubInPlace(acc, ctX);
+        cc.EvalNegateInPlace(acc);
+        cc.EvalRotateInPlace(acc, 1);
+
+        const decrypted = cc.Decrypt(kp.secretKey, acc);
+        decrypted.SetLength(x.length);
+        const got = copyVecToJs(decrypted.GetPackedValue());
+
+        // the rotation pulls in the zero slot past the end of the input
+        expected[x.length - 1] = 0;
+        assert.deepEqual(expected, got);
+
+        // the second operand must be left untouched
+        const decryptedY = cc.Decrypt(kp.secretKey, ctY);
+        decryptedY.SetLength(y.length);
+        assert.deepEqual(y, copyVecToJs(decryptedY.GetPackedValue()));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('CryptoContext', () => {
+    describe('#EvalAddInPlace()', () => {
+        it('Should accumulate into the first ciphertext', TestBFVInPlaceAccumulate)
+            .timeout(10000)
+    });
+});
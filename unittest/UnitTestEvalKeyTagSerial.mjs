@@ -0,0 +1,64 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {copyVecToJs, setupParamsBFV,} from "./common.mjs";
+
+async function TestSerializeOneTenantsKeys() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextBFVRNS();
+    params = await setupParamsBFV(params);
+    const cc = new module.GenCryptoContextBFV(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    cc.Enable(module.PKESchemeFeature.LEVELEDSHE);
+
+    try {
+        const [kpA, kpB] = [cc.KeyGen(), cc.KeyGen()];
+        for (const kp of [kpA, kpB]) {
+            cc.EvalMultKeyGen(kp.secretKey);
+            cc.EvalAtIndexKeyGen(kp.secretKey, [1, 2, 3]);
+        }
+        const [tagA, tagB] = [kpA.secretKey.GetKeyTag(), kpB.secretKey.GetKeyTag()];
+        const serType = module.SerType.BINARY;
+
+        const allRotations = cc.SerializeEvalAutomorphismKeyToBuffer(serType);
+        const multA = cc.SerializeEvalMultKeyForTagToBuffer(tagA, serType);
+        const rotationsA = cc.SerializeEvalAutomorphismKeyForTagToBuffer(tagA, [1], serType);
+        assert.ok(multA.length < cc.SerializeEvalMultKeyToBuffer(serType).length);
+        assert.ok(rotationsA.length < cc.SerializeEvalAutomorphismKeyForTagToBuffer(tagA, undefined, serType).length);
+
+        cc.ClearEvalMultKeys();
+        cc.ClearEvalAutomorphismKeys();
+        cc.DeserializeEvalMultKeyFromBuffer(multA, serType);
+        cc.DeserializeEvalAutomorphismKeyFromBuffer(rotationsA, serType);
+        // tenant A's key for rotation 2 only, picked from the buffer holding every tenant's keys
+        cc.DeserializeEvalAutomorphismKeyForTagFromBuffer(allRotations, tagA, [2], serType);
+
+        assert.throws(() => cc.SerializeEvalMultKeyForTagToBuffer(tagB, serType));
+        assert.throws(() => cc.SerializeEvalAutomorphismKeyForTagToBuffer(tagB, undefined, serType));
+        assert.throws(() => cc.SerializeEvalAutomorphismKeyForTagToBuffer(tagA, [3], serType));
+
+        const x = [1, 2, 3, 4, 5, 6, 7, 8];
+        const ciphertext = cc.Encrypt(kpA.publicKey, cc.MakePackedPlaintext(module.MakeVectorInt64Clipped(x)));
+        for (const index of [1, 2]) {
+            const decrypted = cc.Decrypt(kpA.secretKey, cc.EvalAtIndex(ciphertext, index));
+            decrypted.SetLength(x.length - index);
+            assert.deepEqual(x.slice(index), copyVecToJs(decrypted.GetPackedValue()));
+        }
+        const squared = cc.Decrypt(kpA.secretKey, cc.EvalMult(ciphertext, ciphertext));
+        squared.SetLength(x.length);
+        assert.deepEqual(x.map(v => v * v), copyVecToJs(squared.GetPackedValue()));
+
+        cc.ClearEvalMultKeys();
+        cc.ClearEvalAutomorphismKeys();
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('Serialization', () => {
+    describe('#SerializeEvalAutomorphismKeyForTagToBuffer()', () => {
+        it('Should serialize and load the keys of one key tag and index subset', TestSerializeOneTenantsKeys)
+            .timeout(20000)
+    });
+});
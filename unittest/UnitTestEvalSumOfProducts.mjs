@@ -0,0 +1,56 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {copyVecToJs, setupCCBFV, setupParamsBFV,} from "./common.mjs";
+
+const xs = [[1, 2, 3], [4, 5, 6], [7, 8, 9], [-1, 0, 2]];
+const ys = [[2, 2, 2], [1, -1, 1], [0, 3, 1], [5, 5, 5]];
+
+function sumOfProducts(x, y) {
+    return x[0].map((_, slot) => x.reduce((sum, row, i) => sum + row[slot] * y[i][slot], 0));
+}
+
+async function TestBFVEvalSumOfProducts() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextBFVRNS();
+    params = await setupParamsBFV(params);
+    let cc = new module.GenCryptoContextBFV(params);
+    let kp = undefined;
+    [cc, kp] = await setupCCBFV(cc);
+
+    try {
+        const encrypt = row => cc.Encrypt(kp.publicKey, cc.MakePackedPlaintext(module.MakeVectorInt64Clipped(row)));
+        const cts1 = xs.map(encrypt);
+        const cts2 = ys.map(encrypt);
+        const expected = sumOfProducts(xs, ys);
+
+        const fused = cc.Decrypt(kp.secretKey, cc.EvalSumOfProducts(cts1, cts2));
+        fused.SetLength(expected.length);
+        assert.deepEqual(expected, copyVecToJs(fused.GetPackedValue()));
+
+        // the same sum written out with the deferred relinearization primitives
+        const acc = cc.EvalMultNoRelin(cts1[0], cts2[0]);
+        for (let i = 1; i < cts1.length; i++) {
+            cc.EvalAddInPlace(acc, cc.EvalMultNoRelin(cts1[i], cts2[i]));
+        }
+        const relinearized = cc.Relinearize(acc);
+        cc.RelinearizeInPlace(acc);
+        for (const ct of [relinearized, acc]) {
+            const decrypted = cc.Decrypt(kp.secretKey, ct);
+            decrypted.SetLength(expected.length);
+            assert.deepEqual(expected, copyVecToJs(decrypted.GetPackedValue()));
+        }
+
+        assert.throws(() => cc.EvalSumOfProducts(cts1, cts2.slice(1)));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('CryptoContext', () => {
+    describe('#EvalSumOfProducts()', () => {
+        it('Should relinearize the sum of products once', TestBFVEvalSumOfProducts)
+            .timeout(10000)
+    });
+});
@@ -0,0 +1,67 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {setupCCBGV} from "./common.mjs";
+
+// 46-bit prime, 1 mod 2^17, so it supports packing for ring dimensions up to 2^16
+const plaintextModulus = 35184372744193n;
+
+async function setupCC(module) {
+    let params = new module.CCParamsCryptoContextBGVRNS();
+    params.SetPlaintextModulus(plaintextModulus);
+    params.SetMultiplicativeDepth(1);
+    params.SetSecurityLevel(module.SecurityLevel.HEStd_NotSet);
+    params.SetRingDim(1 << 7);
+    assert.equal(params.GetPlaintextModulusBigInt(), plaintextModulus);
+    assert.equal(params.GetPlaintextModulus(), Number(plaintextModulus));
+    return setupCCBGV(new module.GenCryptoContextBGV(params));
+}
+
+async function TestPackedInt64RoundTrip() {
+    const module = await factory();
+    const [cc, kp] = await setupCC(module);
+    try {
+        assert.equal(cc.GetPlaintextModulusBigInt(), plaintextModulus);
+        assert.equal(cc.GetCryptoParameters().GetPlaintextModulusBigInt(), plaintextModulus);
+
+        const x = BigInt64Array.from([1n << 44n, (1n << 44n) - 12345n, -5n, 0n, 987654321012n]);
+        const y = BigInt64Array.from([1n, 2n, 3n, 4n, 5n]);
+        const ctX = cc.Encrypt(kp.publicKey, cc.MakePackedPlaintextInt64(x));
+        const ctY = cc.Encrypt(kp.publicKey, cc.MakePackedPlaintextInt64(y));
+
+        const decrypted = cc.Decrypt(kp.secretKey, cc.EvalAddCipherCipher(ctX, ctY));
+        decrypted.SetLength(x.length);
+        const got = decrypted.GetPackedValueInt64();
+        assert.ok(got instanceof BigInt64Array);
+        assert.deepEqual(Array.from(got), Array.from(x, (v, i) => v + y[i]));
+    } catch (error) {
+        const msg = typeof error === 'number' ?
+            module.getExceptionMessage(error) : error
+        throw new Error(msg)
+    }
+}
+
+async function TestMakeVectorInt64() {
+    const module = await factory();
+    const fromBigInts = module.MakeVectorInt64(BigInt64Array.from([-(1n << 50n), 1n << 52n]));
+    assert.equal(fromBigInts.get(0), -(1n << 50n));
+    assert.equal(fromBigInts.get(1), 1n << 52n);
+    // Numbers are exact up to 2^53 instead of being clipped to int32
+    const fromNumbers = module.MakeVectorInt64([2 ** 40, -3]);
+    assert.equal(fromNumbers.get(0), 1n << 40n);
+    assert.equal(fromNumbers.get(1), -3n);
+    // Numbers that are not exact integers are rejected instead of truncated
+    assert.throws(() => module.MakeVectorInt64([1.5]));
+    assert.throws(() => module.MakeVectorInt64([2 ** 60]));
+    assert.throws(() => module.MakeVectorInt64([NaN]));
+}
+
+describe('Plaintext', () => {
+    describe('#GetPackedValueInt64()', () => {
+        it('Should round-trip 44-bit values with a 46-bit plaintext modulus', TestPackedInt64RoundTrip)
+            .timeout(10000)
+    });
+    describe('#MakeVectorInt64()', () => {
+        it('Should convert BigInt64Array and Numbers without clipping', TestMakeVectorInt64)
+            .timeout(10000)
+    });
+});
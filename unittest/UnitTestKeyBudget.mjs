@@ -0,0 +1,116 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {copyVecToJs, setupCCBFV, setupParamsBFV,} from "./common.mjs";
+
+async function TestEvictAndReloadUnderBudget() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextBFVRNS();
+    params = await setupParamsBFV(params);
+    const cc = new module.GenCryptoContextBFV(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    cc.Enable(module.PKESchemeFeature.LEVELEDSHE);
+
+    try {
+        const tenants = [cc.KeyGen(), cc.KeyGen()];
+        for (const kp of tenants) cc.EvalMultKeyGen(kp.secretKey);
+        const tags = tenants.map(kp => kp.secretKey.GetKeyTag());
+
+        // keep a serialized copy for the reloader, as a host would in storage
+        const stored = cc.SerializeEvalMultKeyToBuffer(module.SerType.BINARY);
+        module.SetEvalKeyReloader(() => ({evalMultKey: stored, serType: module.SerType.BINARY}));
+
+        // the native module is shared by all test files, track only this test's tags
+        module.ClearKeyBudget();
+        module.SetEvalKeyBudget(0);
+        assert.ok(cc.EnsureEvalKeys(tags[0]));
+        assert.ok(cc.EnsureEvalKeys(tags[1]));
+        const oneTenant = module.GetResidentEvalKeyBytes() / 2;
+        assert.ok(oneTenant > 0);
+
+        // room for one tenant: touching the second evicts the first
+        const evictions = module.GetKeyEvictions();
+        module.SetEvalKeyBudget(oneTenant);
+        assert.ok(cc.EnsureEvalKeys(tags[1]));
+        assert.equal(module.GetKeyEvictions() - evictions, 1);
+        assert.ok(module.IsEvalKeyEvicted(tags[0]));
+        assert.equal(module.GetResidentKeyTags(), 1);
+
+        // serving the first tenant again reloads its keys and evicts the second
+        const reloads = module.GetKeyReloads();
+        assert.ok(cc.EnsureEvalKeys(tags[0]));
+        assert.ok(module.GetKeyReloads() > reloads);
+        assert.ok(!module.IsEvalKeyEvicted(tags[0]));
+        assert.ok(module.IsEvalKeyEvicted(tags[1]));
+        assert.ok(module.GetResidentEvalKeyBytes() <= oneTenant);
+
+        const x = [1, 2, 3];
+        const plaintext = cc.MakePackedPlaintext(module.MakeVectorInt64Clipped(x));
+        const ciphertext = cc.Encrypt(tenants[0].publicKey, plaintext);
+        const decrypted = cc.Decrypt(tenants[0].secretKey, cc.EvalMult(ciphertext, ciphertext));
+        decrypted.SetLength(x.length);
+        assert.deepEqual(x.map(v => v * v), copyVecToJs(decrypted.GetPackedValue()));
+
+        // evicting the context keeps its tags tracked, so they are still reloaded
+        module.EvictCryptoContext(cc);
+        assert.equal(module.GetResidentKeyTags(), 0);
+        assert.equal(module.GetResidentEvalKeyBytes(), 0);
+        assert.ok(module.IsEvalKeyEvicted(tags[0]));
+        assert.ok(cc.EnsureEvalKeys(tags[0]));
+        assert.equal(module.GetResidentKeyTags(), 1);
+        module.ClearKeyBudget();
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+async function TestClearKeysPerContext() {
+    const module = await factory();
+
+    const contexts = [];
+    for (const depth of [2, 3]) {
+        let params = await new module.CCParamsCryptoContextBFVRNS();
+        params = await setupParamsBFV(params);
+        params.SetMultiplicativeDepth(depth);
+        contexts.push(await setupCCBFV(new module.GenCryptoContextBFV(params), [1, 2]));
+    }
+    const [[ccA, kpA], [ccB, kpB]] = contexts;
+    const [tagA, tagB] = [kpA.secretKey.GetKeyTag(), kpB.secretKey.GetKeyTag()];
+    const serType = module.SerType.BINARY;
+
+    try {
+        ccA.ClearEvalMultKeys();
+        ccA.ClearEvalAutomorphismKeys();
+        ccA.ClearEvalSumKeys();
+        assert.throws(() => ccA.SerializeEvalMultKeyForTagToBuffer(tagA, serType));
+        assert.throws(() => ccA.SerializeEvalAutomorphismKeyForTagToBuffer(tagA, undefined, serType));
+
+        // the other tenant's keys survive
+        const x = [1, 2, 3, 4];
+        const ciphertext = ccB.Encrypt(kpB.publicKey, ccB.MakePackedPlaintext(module.MakeVectorInt64Clipped(x)));
+        const squared = ccB.Decrypt(kpB.secretKey, ccB.EvalMult(ciphertext, ciphertext));
+        squared.SetLength(x.length);
+        assert.deepEqual(x.map(v => v * v), copyVecToJs(squared.GetPackedValue()));
+        const rotated = ccB.Decrypt(kpB.secretKey, ccB.EvalAtIndex(ciphertext, 1));
+        rotated.SetLength(x.length - 1);
+        assert.deepEqual(x.slice(1), copyVecToJs(rotated.GetPackedValue()));
+
+        ccB.ClearEvalMultKeys();
+        ccB.ClearEvalAutomorphismKeys();
+        assert.throws(() => ccB.SerializeEvalMultKeyForTagToBuffer(tagB, serType));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('Key budget', () => {
+    describe('#EnsureEvalKeys()', () => {
+        it('Should evict least recently used keys and reload them on demand', TestEvictAndReloadUnderBudget)
+            .timeout(20000)
+    });
+    describe('#ClearEvalMultKeys()', () => {
+        it('Should clear only the keys of its own context', TestClearKeysPerContext).timeout(20000)
+    });
+});
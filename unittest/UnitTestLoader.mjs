@@ -0,0 +1,88 @@
+import assert from 'assert'
+import loader from '../lib/openfhe_loader.js'
+import factory from '../lib/openfhe_pke.js'
+import {copyVecToJs, setupParamsBFV,} from "./common.mjs";
+
+async function encryptDecrypt(module) {
+    let params = await new module.CCParamsCryptoContextBFVRNS();
+    params = await setupParamsBFV(params);
+    const cc = new module.GenCryptoContextBFV(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    const kp = cc.KeyGen();
+    const x = [1, 2, 3];
+    const ciphertext = cc.Encrypt(kp.publicKey, cc.MakePackedPlaintext(module.MakeVectorInt64Clipped(x)));
+    const decrypted = cc.Decrypt(kp.secretKey, ciphertext);
+    decrypted.SetLength(x.length);
+    assert.deepEqual(x, copyVecToJs(decrypted.GetPackedValue()));
+}
+
+async function TestInstancesShareCompiledModule() {
+    const [first, second] = await Promise.all([loader.instantiate(), loader.instantiate()]);
+    try {
+        await encryptDecrypt(first);
+        await encryptDecrypt(second);
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(first.getExceptionMessage(error)) : error
+    }
+}
+
+async function TestInstantiateRejectsOnLinkError() {
+    if (factory.native) return;
+    // imports function "fn" of module "no", which the glue code does not provide
+    const wasmModule = await WebAssembly.compile(new Uint8Array([
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+        0x01, 0x04, 0x01, 0x60, 0x00, 0x00,
+        0x02, 0x09, 0x01, 0x02, 0x6e, 0x6f, 0x02, 0x66, 0x6e, 0x00, 0x00]));
+    await assert.rejects(loader.instantiate({wasmModule}));
+}
+
+async function TestPoolResetsInstances() {
+    if (factory.native) {
+        assert.throws(() => new loader.InstancePool(2), TypeError);
+        return;
+    }
+    const pool = new loader.InstancePool(2);
+    const instance = await pool.acquire();
+    try {
+        await encryptDecrypt(instance);
+        instance.SetEvalKeyBudget(1 << 20);
+        pool.release(instance);
+
+        await pool.run(async module => {
+            assert.equal(module.GetEvalKeyBudget(), 0);
+            assert.equal(module.GetCryptoContextCacheSize(), 0);
+            await encryptDecrypt(module);
+        });
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(instance.getExceptionMessage(error)) : error
+    }
+}
+
+async function TestPoolReleasesBinFHEInstances() {
+    const pool = new loader.InstancePool(1, {name: 'openfhe_binfhe'});
+    await pool.run(async module => {
+        const cc = new module.BinFHEContext();
+        cc.GenerateBinFHEContext(module.BINFHE_PARAMSET.TOY, module.BINFHE_METHOD.GINX);
+        const sk = cc.KeyGen();
+        assert.equal(1, cc.Decrypt(sk, cc.Encrypt(sk, 1)));
+    });
+    // the reset on release must not call the pke-only bindings
+    await pool.run(async module => assert.ok(module.BinFHEContext));
+}
+
+describe('Loader', () => {
+    describe('#instantiate()', () => {
+        it('Should create working instances from one compiled module', TestInstancesShareCompiledModule)
+            .timeout(20000)
+        it('Should reject when the module fails to instantiate', TestInstantiateRejectsOnLinkError)
+            .timeout(20000)
+    });
+    describe('#InstancePool', () => {
+        it('Should hand out reset instances', TestPoolResetsInstances)
+            .timeout(20000)
+        it('Should hand out BinFHE instances', TestPoolReleasesBinFHEInstances)
+            .timeout(20000)
+    });
+});
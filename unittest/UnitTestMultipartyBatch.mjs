@@ -0,0 +1,50 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {copyVecToJs, setupParamsBFV,} from "./common.mjs";
+
+async function TestBFVBatchedThresholdDecryption() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextBFVRNS();
+    params = await setupParamsBFV(params);
+    const cc = new module.GenCryptoContextBFV(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    cc.Enable(module.PKESchemeFeature.KEYSWITCH);
+    cc.Enable(module.PKESchemeFeature.LEVELEDSHE);
+    cc.Enable(module.PKESchemeFeature.MULTIPARTY);
+
+    try {
+        const kp1 = cc.KeyGen();
+        const kp2 = cc.MultipartyKeyGen(kp1.publicKey);
+
+        const inputs = [[1, 2, 3], [4, 5, 6], [7, 8, 9], [10, 11, 12]];
+        const ciphertexts = inputs.map(x => cc.Encrypt(kp2.publicKey,
+            cc.MakePackedPlaintext(module.MakeVectorInt64Clipped(x))));
+
+        const lead = cc.MultipartyDecryptLeadBatch(kp1.secretKey, ciphertexts, 0);
+        const main = cc.MultipartyDecryptMainBatch(kp2.secretKey, ciphertexts, 0);
+
+        // the compact batch is smaller than the cereal partial decryptions
+        const partialVec = cc.MultipartyDecryptLead(kp1.secretKey, [ciphertexts[0]]);
+        const cerealBuffer = module.SerializeCiphertextToBuffer(partialVec.get(0), module.SerType.BINARY);
+        assert(lead.byteLength < inputs.length * cerealBuffer.byteLength);
+
+        const fused = cc.MultipartyDecryptFusionBatch([lead, main]);
+        assert.equal(fused.length, inputs.length);
+        const got = fused.map(plaintext => {
+            plaintext.SetLength(3);
+            return copyVecToJs(plaintext.GetPackedValue());
+        });
+        assert.deepEqual(inputs, got);
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('CryptoContext', () => {
+    describe('#MultipartyDecryptFusionBatch()', () => {
+        it('Should fuse compact partial decryption batches', TestBFVBatchedThresholdDecryption)
+            .timeout(20000)
+    });
+});
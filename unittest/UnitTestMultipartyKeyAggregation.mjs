@@ -0,0 +1,78 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {copyVecToJs, setupParamsBFV,} from "./common.mjs";
+
+const numParties = 3;
+
+function fuse(cc, parties, ciphertext) {
+    const partials = [cc.MultipartyDecryptLead(parties[0].secretKey, [ciphertext]).get(0)];
+    for (let i = 1; i < parties.length; i++) {
+        partials.push(cc.MultipartyDecryptMain(parties[i].secretKey, [ciphertext]).get(0));
+    }
+    return cc.MultipartyDecryptFusion(partials);
+}
+
+async function TestNPartyEvalKeyAggregation() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextBFVRNS();
+    params = await setupParamsBFV(params);
+    const cc = new module.GenCryptoContextBFV(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    cc.Enable(module.PKESchemeFeature.KEYSWITCH);
+    cc.Enable(module.PKESchemeFeature.LEVELEDSHE);
+    cc.Enable(module.PKESchemeFeature.ADVANCEDSHE);
+    cc.Enable(module.PKESchemeFeature.MULTIPARTY);
+
+    try {
+        const parties = [cc.KeyGen()];
+        for (let i = 1; i < numParties; i++) {
+            parties.push(cc.MultipartyKeyGen(parties[i - 1].publicKey));
+        }
+        const jointPublicKey = parties[numParties - 1].publicKey;
+        const jointTag = jointPublicKey.GetKeyTag();
+
+        // relinearization key
+        const evalMultKey = cc.KeySwitchGen(parties[0].secretKey, parties[0].secretKey);
+        const evalMultShares = [evalMultKey];
+        for (let i = 1; i < numParties; i++) {
+            evalMultShares.push(cc.MultiKeySwitchGen(parties[i].secretKey, parties[i].secretKey, evalMultKey));
+        }
+        const evalMultJoint = cc.MultiAddEvalKeysBatch(evalMultShares, jointTag);
+        const evalMultFinalShares = parties.map(
+            party => cc.MultiMultEvalKey(party.secretKey, evalMultJoint, jointTag));
+        const evalMultFinal = cc.MultiAddEvalMultKeysBatch(evalMultFinalShares, evalMultJoint.GetKeyTag());
+        cc.InsertEvalMultKey([evalMultFinal]);
+
+        // rotation keys
+        const indices = [1, 2];
+        cc.EvalAtIndexKeyGen(parties[0].secretKey, indices);
+        const leadRotationKeys = cc.GetEvalAutomorphismKeyMap(parties[0].secretKey.GetKeyTag());
+        const rotationShares = [leadRotationKeys];
+        for (let i = 1; i < numParties; i++) {
+            rotationShares.push(cc.MultiEvalAtIndexKeyGen(parties[i].secretKey, leadRotationKeys, indices, jointTag));
+        }
+        cc.InsertEvalAutomorphismKey(cc.MultiAddEvalAutomorphismKeysBatch(rotationShares, jointTag), jointTag);
+
+        const x = [1, 2, 3, 4];
+        const ciphertext = cc.Encrypt(jointPublicKey, cc.MakePackedPlaintext(module.MakeVectorInt64Clipped(x)));
+
+        const squared = fuse(cc, parties, cc.EvalMultCipherCipher(ciphertext, ciphertext));
+        squared.SetLength(x.length);
+        assert.deepEqual(x.map(v => v * v), copyVecToJs(squared.GetPackedValue()));
+
+        const rotated = fuse(cc, parties, cc.EvalAtIndex(ciphertext, 2));
+        rotated.SetLength(2);
+        assert.deepEqual([3, 4], copyVecToJs(rotated.GetPackedValue()));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('CryptoContext', () => {
+    describe('#MultiAddEvalMultKeysBatch()', () => {
+        it('Should build joint eval keys for N parties', TestNPartyEvalKeyAggregation)
+            .timeout(60000)
+    });
+});
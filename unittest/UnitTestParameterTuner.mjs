@@ -0,0 +1,76 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+
+async function TestTuneCKKS() {
+    const module = await factory();
+
+    try {
+        const workload = {
+            securityLevel: module.SecurityLevel.HEStd_NotSet,
+            ringDimension: 1 << 10,
+            multiplicativeDepth: 2,
+            rotations: [1, -2],
+            ops: {mult: 2, add: 4, rotate: 2},
+            precisionBits: 12,
+        };
+        const candidates = [
+            {scalingModSize: 40, keySwitchTechnique: module.KeySwitchTechnique.BV},
+            {scalingModSize: 40, keySwitchTechnique: module.KeySwitchTechnique.HYBRID, numLargeDigits: 2},
+            // too little precision for the target
+            {scalingModSize: 14, firstModSize: 30},
+        ];
+        let progress = 0;
+        const tuned = await module.TuneParameters(workload, {candidates, repetitions: 1, onProgress: () => progress++});
+        assert.equal(progress, candidates.length);
+        assert.equal(tuned.results.length, candidates.length);
+        assert(!tuned.results[2].ok);
+        assert(candidates.slice(0, 2).includes(tuned.settings));
+        assert(tuned.results.filter(r => r.ok).every(r => r.msPerWorkload >= tuned.msPerWorkload));
+
+        // the winning parameters generate a working context
+        const cc = new module.GenCryptoContextCKKS(tuned.params);
+        assert.equal(cc.GetRingDimension(), 1 << 10);
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+async function TestTuneBFV() {
+    const module = await factory();
+
+    try {
+        const workload = {
+            scheme: 'BFV',
+            securityLevel: module.SecurityLevel.HEStd_NotSet,
+            ringDimension: 1 << 7,
+            multiplicativeDepth: 2,
+        };
+        const candidates = ['HPS', 'BEHZ', 'HPSPOVERQLEVELED'].map(name => ({
+            multiplicationTechnique: module.MultiplicationTechnique[name],
+            encryptionTechnique: module.EncryptionTechnique.EXTENDED,
+        }));
+        const tuned = await module.TuneParameters(workload, {candidates, repetitions: 1});
+        tuned.results.forEach(result => assert(result.ok, result.error));
+        assert(tuned.msPerWorkload > 0);
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+async function TestRejectUnknownOps() {
+    const module = await factory();
+
+    await assert.rejects(module.TuneParameters({ops: {mult: 1, bootstrap: 1}}), /unknown op bootstrap/);
+    await assert.rejects(module.TuneParameters({ops: {mult: '1'}}), /non-negative number/);
+    await assert.rejects(module.TuneParameters({ops: {rotate: 2}}), /rotations/);
+}
+
+describe('TuneParameters', () => {
+    it('Should pick the fastest CKKS parameters meeting the precision target', TestTuneCKKS)
+        .timeout(60000)
+    it('Should compare BFV multiplication techniques', TestTuneBFV)
+        .timeout(60000)
+    it('Should reject workloads with unknown ops', TestRejectUnknownOps)
+});
@@ -0,0 +1,53 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {copyVecToJs, setupCCCKKS, setupParamsCKKS,} from "./common.mjs";
+
+async function TestRawRoundTrip() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextCKKSRNS();
+    params = await setupParamsCKKS(params);
+    let cc = new module.GenCryptoContextCKKS(params);
+    let kp = undefined;
+    [cc, kp] = await setupCCCKKS(cc);
+
+    try {
+        const x = [0.5, 1.0, 1.5, 2.0];
+        const fresh = cc.Encrypt(kp.publicKey, cc.MakeCKKSPackedPlaintext(new module.VectorDouble(x)));
+        // after two multiplications the ciphertext has fewer towers than the context
+        const cubed = cc.EvalMultCipherCipher(cc.EvalMultCipherCipher(fresh, fresh), fresh);
+
+        for (const [ciphertext, expected] of [[fresh, x], [cubed, x.map(v => v * v * v)]]) {
+            const buffer = module.SerializeCiphertextToRawBuffer(cc, ciphertext);
+            const decoded = module.DeserializeCiphertextFromRawBuffer(cc, buffer);
+            assert.equal(decoded.GetKeyTag(), ciphertext.GetKeyTag());
+
+            // the key tag travels along, so the eval keys are found
+            const squared = cc.EvalMultCipherCipher(decoded, decoded);
+            for (const [result, values] of [[decoded, expected], [squared, expected.map(v => v * v)]]) {
+                const decrypted = cc.Decrypt(kp.secretKey, result);
+                decrypted.SetLength(values.length);
+                const got = copyVecToJs(decrypted.GetRealPackedValue());
+                values.forEach((value, idx) => assert(Math.abs(value - got[idx]) < 1e-3));
+            }
+        }
+
+        // a context with another moduli chain is rejected
+        let otherParams = await new module.CCParamsCryptoContextCKKSRNS();
+        otherParams = await setupParamsCKKS(otherParams);
+        otherParams.SetMultiplicativeDepth(1);
+        const other = new module.GenCryptoContextCKKS(otherParams);
+        const buffer = module.SerializeCiphertextToRawBuffer(cc, fresh);
+        assert.throws(() => module.DeserializeCiphertextFromRawBuffer(other, buffer));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('Serialization', () => {
+    describe('#SerializeCiphertextToRawBuffer()', () => {
+        it('Should round-trip ciphertexts between identical contexts', TestRawRoundTrip)
+            .timeout(30000)
+    });
+});
@@ -0,0 +1,73 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {copyVecToJs, setupCCCKKS, setupParamsCKKS,} from "./common.mjs";
+
+function rotate(x, index) {
+    const n = x.length;
+    const r = ((index % n) + n) % n;
+    return x.slice(r).concat(x.slice(0, r));
+}
+
+async function TestPlannedRotations() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextCKKSRNS();
+    params = await setupParamsCKKS(params);
+    let cc = new module.GenCryptoContextCKKS(params);
+    let kp = undefined;
+    [cc, kp] = await setupCCCKKS(cc);
+
+    try {
+        // more distinct indices than the budget, with 3 as the hot index
+        const workload = [-1, ...new Array(10).fill(3)];
+        for (let i = 5; i <= 32; i++) workload.push(i);
+        const slots = cc.GetRingDimension() / 2;
+        // the powers of two and their negatives, plus one key
+        const maxKeys = 2 * Math.log2(slots);
+        const plan = cc.PlanRotationKeys(workload, maxKeys);
+
+        assert.equal(plan.GetNumKeys(), maxKeys);
+        // -1 is a generator, so the extra key goes to the hot index
+        assert.equal(plan.GetKeySwitches(-1), 1);
+        assert.equal(plan.GetKeySwitches(3), 1);
+        assert.equal(plan.GetKeySwitches(5), 2);
+        assert(plan.GetExtraKeySwitches() > 0);
+        assert(plan.GetMaxKeySwitches() >= 1);
+        workload.forEach(index => assert(plan.GetKeySwitches(index) >= 1));
+
+        // a hot negative index does not crowd out a hot positive one
+        const mixed = [...new Array(10).fill(-5), ...new Array(10).fill(3)];
+        for (let i = 6; i <= 32; i++) mixed.push(i);
+        const mixedPlan = cc.PlanRotationKeys(mixed, maxKeys + 1);
+        assert.equal(mixedPlan.GetKeySwitches(-5), 1);
+        assert.equal(mixedPlan.GetKeySwitches(3), 1);
+
+        cc.EvalAtIndexKeyGenPlanned(kp.secretKey, plan);
+        // a key of its own is used directly instead of composing the plan's steps
+        cc.EvalAtIndexKeyGen(kp.secretKey, [11]);
+
+        // CKKS replicates the input across all slots, so slot-vector rotation
+        // by the batch size is observable on the first batchSize entries.
+        const x = [1, 2, 3, 4, 5, 6, 7, 8];
+        const ciphertext = cc.Encrypt(kp.publicKey,
+            cc.MakeCKKSPackedPlaintext(new module.VectorDouble(x)));
+        for (const index of [5, 7, -1, 11]) {
+            const decrypted = cc.Decrypt(kp.secretKey, cc.EvalAtIndex(ciphertext, index));
+            decrypted.SetLength(x.length);
+            const got = copyVecToJs(decrypted.GetRealPackedValue());
+            const expected = rotate(x, index);
+            expected.forEach((value, idx) => assert(Math.abs(value - got[idx]) < 1e-3));
+        }
+        cc.ClearEvalAutomorphismKeys();
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('CryptoContext', () => {
+    describe('#PlanRotationKeys()', () => {
+        it('Should compose workload rotations from a small key set', TestPlannedRotations)
+            .timeout(60000)
+    });
+});
@@ -0,0 +1,68 @@
+import assert from 'assert'
+import {MessageChannel} from 'worker_threads'
+import factory from '../lib/openfhe_pke.js'
+import {copyVecToJs, setupParamsBFV,} from "./common.mjs";
+
+async function TestSharedSerializedKeyCache() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextBFVRNS();
+    params = await setupParamsBFV(params);
+    const cc = new module.GenCryptoContextBFV(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    cc.Enable(module.PKESchemeFeature.KEYSWITCH);
+    cc.Enable(module.PKESchemeFeature.LEVELEDSHE);
+
+    try {
+        const kp = cc.KeyGen();
+        cc.EvalMultKeyGen(kp.secretKey);
+        cc.EvalAtIndexKeyGen(kp.secretKey, [1, 2, 3]);
+        const keyTag = kp.secretKey.GetKeyTag();
+
+        const cache = module.SharedSerializedKeyCache.create(cc, keyTag, {rotations: [1, 2, 3]});
+        assert(cache.descriptor.buffer instanceof SharedArrayBuffer);
+
+        // posting the descriptor shares the buffer, as with a Worker
+        const {port1, port2} = new MessageChannel();
+        const received = new Promise(resolve => port2.once('message', resolve));
+        port1.postMessage(cache.descriptor);
+        const descriptor = await received;
+        port1.close();
+        new Uint8Array(descriptor.buffer)[0] ^= 0xff;
+        assert.equal(new Uint8Array(descriptor.buffer)[0], new Uint8Array(cache.descriptor.buffer)[0]);
+        new Uint8Array(descriptor.buffer)[0] ^= 0xff;
+
+        // a worker starts without keys and loads the ones its queries use
+        module.ClearAllEvalKeys();
+        const workerCache = new module.SharedSerializedKeyCache(descriptor);
+        workerCache.ensure(cc, [2]);
+
+        const x = [1, 2, 3, 4, 5, 6, 7, 8];
+        const ciphertext = cc.Encrypt(kp.publicKey, cc.MakePackedPlaintext(module.MakeVectorInt64Clipped(x)));
+        assert.throws(() => cc.EvalAtIndex(ciphertext, 1));
+        const decrypt = ct => {
+            const decrypted = cc.Decrypt(kp.secretKey, cc.EvalMultCipherCipher(ct, ct));
+            decrypted.SetLength(4);
+            return copyVecToJs(decrypted.GetPackedValue()).map(Number);
+        };
+        assert.deepEqual(decrypt(cc.EvalAtIndex(ciphertext, 2)), [9, 16, 25, 36]);
+
+        workerCache.ensure(cc, [1]);
+        assert.deepEqual(decrypt(cc.EvalAtIndex(ciphertext, 1)), [4, 9, 16, 25]);
+        assert.deepEqual(decrypt(cc.EvalAtIndex(ciphertext, 2)), [9, 16, 25, 36]);
+        assert.throws(() => workerCache.ensure(cc, [4]), /no rotation key/);
+
+        workerCache.release();
+        assert.throws(() => cc.EvalAtIndex(ciphertext, 2));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('SharedSerializedKeyCache', () => {
+    describe('#ensure()', () => {
+        it('Should load only the requested keys from the shared buffer', TestSharedSerializedKeyCache)
+            .timeout(20000)
+    });
+});
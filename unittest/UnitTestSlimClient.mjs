@@ -0,0 +1,51 @@
+import assert from 'assert'
+import fs from 'fs'
+import {createRequire} from 'module'
+import factory from '../lib/openfhe_pke.js'
+import {copyVecToJs, setupParamsCKKS,} from "./common.mjs";
+
+const require = createRequire(import.meta.url);
+const clientPath = new URL('../lib/openfhe_pke_encrypt_ckks.js', import.meta.url);
+
+async function TestEncryptOnlyClient() {
+    const module = await factory();
+    const client = await require(clientPath.pathname)();
+
+    let params = await new module.CCParamsCryptoContextCKKSRNS();
+    params = await setupParamsCKKS(params);
+    const cc = new module.GenCryptoContextCKKS(params);
+    cc.Enable(module.PKESchemeFeature.PKE);
+    const kp = cc.KeyGen();
+
+    try {
+        // the client only gets the context and the public key
+        const clientCC = client.DeserializeCryptoContextFromBuffer(
+            module.SerializeCryptoContextToBuffer(cc, module.SerType.BINARY), client.SerType.BINARY);
+        const publicKey = client.DeserializePublicKeyFromBuffer(
+            module.SerializePublicKeyToBuffer(kp.publicKey, module.SerType.BINARY), client.SerType.BINARY);
+        assert.equal(client.DeserializePrivateKeyFromBuffer, undefined);
+        assert.equal(clientCC.Decrypt, undefined);
+
+        const x = [0.25, 0.5, 1.0, 2.0];
+        const plaintext = clientCC.MakeCKKSPackedPlaintext(new client.VectorDouble(x));
+        const buffer = client.SerializeCiphertextToBuffer(clientCC.Encrypt(publicKey, plaintext), client.SerType.BINARY);
+
+        const ciphertext = module.DeserializeCiphertextFromBuffer(buffer, module.SerType.BINARY);
+        const decrypted = cc.Decrypt(kp.secretKey, ciphertext);
+        decrypted.SetLength(x.length);
+        const got = copyVecToJs(decrypted.GetRealPackedValue());
+        x.forEach((value, idx) => assert(Math.abs(value - got[idx]) < 1e-3));
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('Slim client', () => {
+    describe('openfhe_pke_encrypt_ckks', () => {
+        it('Should encrypt for the full module with the public key only', async function () {
+            if (!fs.existsSync(clientPath)) this.skip();
+            await TestEncryptOnlyClient();
+        }).timeout(20000)
+    });
+});
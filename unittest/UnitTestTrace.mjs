@@ -0,0 +1,65 @@
+import assert from 'assert'
+import factory from '../lib/openfhe_pke.js'
+import {setupCCBFV, setupParamsBFV,} from "./common.mjs";
+
+function contains(outer, inner) {
+    return outer.ts <= inner.ts && inner.ts + inner.dur <= outer.ts + outer.dur;
+}
+
+async function TestTraceSpans() {
+    const module = await factory();
+
+    let params = await new module.CCParamsCryptoContextBFVRNS();
+    params = await setupParamsBFV(params);
+    let cc = new module.GenCryptoContextBFV(params);
+    let kp = undefined;
+    [cc, kp] = await setupCCBFV(cc);
+
+    try {
+        const ct = cc.Encrypt(kp.publicKey, cc.MakePackedPlaintext(module.MakeVectorInt64Clipped([1, 2, 3])));
+
+        // nothing is recorded while tracing is off
+        module.ClearTrace();
+        cc.EvalAddCipherCipher(ct, ct);
+        assert.equal(0, module.ExportTrace().traceEvents.length);
+
+        module.StartTracing(1000);
+        assert(module.IsTracing());
+        cc.EvalSumOfProducts([ct, ct], [ct, ct]);
+        module.SerializeCiphertextToBuffer(ct, module.SerType.BINARY);
+        module.StopTracing();
+        cc.EvalAddCipherCipher(ct, ct);
+
+        const trace = module.ExportTrace();
+        const events = trace.traceEvents;
+        assert(events.every(e => e.ph === 'X' && e.dur >= 0));
+        assert.deepEqual(['Relinearize', 'EvalMultNoRelin', 'EvalSumOfProducts', 'SerializeCiphertextToBuffer'].sort(),
+            events.map(e => e.name).sort());
+
+        const outer = events.find(e => e.name === 'EvalSumOfProducts');
+        const relin = events.find(e => e.name === 'Relinearize');
+        assert.equal('binding', outer.cat);
+        assert.equal('openfhe', relin.cat);
+        assert(contains(outer, relin));
+        assert.equal(0, module.GetTraceDroppedEvents());
+
+        // events past the limit are counted, not kept
+        module.StartTracing(1);
+        cc.EvalAddCipherCipher(ct, ct);
+        cc.EvalAddCipherCipher(ct, ct);
+        module.StopTracing();
+        assert.equal(1, module.ExportTrace().traceEvents.length);
+        assert.equal(1, module.GetTraceDroppedEvents());
+        module.ClearTrace();
+    } catch (error) {
+        throw typeof error === 'number' ?
+            new Error(module.getExceptionMessage(error)) : error
+    }
+}
+
+describe('Tracing', () => {
+    describe('#ExportTrace()', () => {
+        it('Should record nested spans of binding calls', TestTraceSpans)
+            .timeout(10000)
+    });
+});
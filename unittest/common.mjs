@@ -1,4 +1,10 @@
 import factory from '../lib/openfhe_pke.js'
+
+// Each factory() call instantiates a new module; the helpers only read
+// enums from it, so they share one instance.
+let modulePromise;
+const getModule = () => modulePromise || (modulePromise = factory());
+
 export function copyVecToJs(vec) {
     return new Array(vec.size()).fill(0).map((_, idx) => vec.get(idx));
 }
@@ -8,7 +14,7 @@ export function copyVecToJs(vec) {
 //////////////////////////////////////////////
 
 export async function setupParamsBFV(params) {
-    const module = await factory();
+    const module = await getModule();
     params.SetPlaintextModulus(65537);
     params.SetMultiplicativeDepth(2);
     params.SetSecurityLevel(module.SecurityLevel.HEStd_NotSet);
@@ -18,7 +24,7 @@ export async function setupParamsBFV(params) {
 
 
 export async function setupCCBFV(cc, indices=undefined) {
-    const module = await factory();
+    const module = await getModule();
     cc.Enable(module.PKESchemeFeature.PKE);
     cc.Enable(module.PKESchemeFeature.LEVELEDSHE);
     cc.Enable(module.PKESchemeFeature.ADVANCEDSHE);
@@ -37,7 +43,7 @@ export async function setupCCBFV(cc, indices=undefined) {
 
 export async function setupParamsBGV(params){
 
-    const module = await factory();
+    const module = await getModule();
     const plaintextMod = 65537;
     const multDepth = 2;
     const sDev = 3.2
@@ -53,7 +59,7 @@ export async function setupParamsBGV(params){
 
 export async function setupCCBGV(cc, indices=undefined) {
 
-    const module = await factory();
+    const module = await getModule();
     cc.Enable(module.PKESchemeFeature.PKE);
     cc.Enable(module.PKESchemeFeature.PRE);
     cc.Enable(module.PKESchemeFeature.LEVELEDSHE);
@@ -77,7 +83,7 @@ export async function setupCCBGV(cc, indices=undefined) {
 
 export async function setupParamsCKKS(params) {
 
-    const module = await factory();
+    const module = await getModule();
     const multDepth = 3;
     const batchSize = 8;
     const scalingModSize = 50;
@@ -92,7 +98,7 @@ export async function setupParamsCKKS(params) {
 
 export async function setupCCCKKS(cc, indices=undefined) {
 
-    const module = await factory();
+    const module = await getModule();
     cc.Enable(module.PKESchemeFeature.PKE);
     cc.Enable(module.PKESchemeFeature.PRE);
     cc.Enable(module.PKESchemeFeature.LEVELEDSHE);